@@ -126,6 +126,59 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
          "incoming_condition_damage_multiplier_add_group"},
     })
 
+inline constexpr std::size_t attribute_count =
+    static_cast<std::size_t>(attribute_t::INCOMING_CONDITION_DAMAGE_MULTIPLIER_ADD_GROUP) + 1;
+
+// Attribute values indexed directly by attribute_t. Behaves like the std::map<attribute_t, double>
+// it replaces: only attributes that have been assigned are present, at() throws for the rest and
+// iteration visits present attributes in enum order.
+struct attribute_values_t {
+    attribute_values_t() = default;
+    attribute_values_t(const std::map<attribute_t, double>& attribute_value_map) {
+        for (auto& [attribute, value] : attribute_value_map) {
+            (*this)[attribute] = value;
+        }
+    }
+
+    [[nodiscard]] inline bool contains(attribute_t attribute) const {
+        return is_present[static_cast<std::size_t>(attribute)];
+    }
+    [[nodiscard]] inline double at(attribute_t attribute) const {
+        if (!contains(attribute)) {
+            throw std::out_of_range("attribute_values_t::at");
+        }
+        return values[static_cast<std::size_t>(attribute)];
+    }
+    inline double& operator[](attribute_t attribute) {
+        is_present[static_cast<std::size_t>(attribute)] = true;
+        return values[static_cast<std::size_t>(attribute)];
+    }
+    template <typename T>
+    inline void for_each(T fn) const {
+        for (std::size_t idx = 0; idx < attribute_count; ++idx) {
+            if (is_present[idx]) {
+                fn(static_cast<attribute_t>(idx), values[idx]);
+            }
+        }
+    }
+
+    std::array<double, attribute_count> values{};
+    std::array<bool, attribute_count> is_present{};
+};
+
+static inline void to_json(nlohmann::json& nlohmann_json_j,
+                           const attribute_values_t& nlohmann_json_t) {
+    std::map<attribute_t, double> attribute_value_map;
+    nlohmann_json_t.for_each(
+        [&](attribute_t attribute, double value) { attribute_value_map[attribute] = value; });
+    nlohmann_json_j = attribute_value_map;
+}
+
+static inline void from_json(const nlohmann::json& nlohmann_json_j,
+                             attribute_values_t& nlohmann_json_t) {
+    nlohmann_json_t = attribute_values_t{nlohmann_json_j.get<std::map<attribute_t, double>>()};
+}
+
 }  // namespace gw2combat::actor
 
 #endif  // GW2COMBAT_ACTOR_ATTRIBUTES_HPP
@@ -1,6 +1,11 @@
 #include "combat_loop.hpp"
 
+#include <atomic>
+#include <functional>
+#include <thread>
+
 #include "mru_cache.hpp"
+#include "single_flight.hpp"
 
 #include "component/actor/begun_casting_skills.hpp"
 #include "component/actor/combat_stats.hpp"
@@ -18,6 +23,7 @@
 #include "component/effect/is_skill_trigger.hpp"
 #include "component/encounter/encounter_configuration_component.hpp"
 #include "component/equipment/bundle.hpp"
+#include "component/hierarchy/children_component.hpp"
 #include "component/lifecycle/destroy_entity.hpp"
 #include "component/skill/ammo.hpp"
 #include "component/skill/is_skill.hpp"
@@ -35,8 +41,11 @@
 #include "system/rotation.hpp"
 #include "system/temporal.hpp"
 
+#include "utils/actor_utils.hpp"
 #include "utils/condition_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
+#include "utils/hash_utils.hpp"
 #include "utils/registry_utils.hpp"
 #include "utils/side_effect_utils.hpp"
 
@@ -50,19 +59,18 @@ void clear_temporary_components(registry_t& registry) {
                    component::is_afk,
                    component::equipped_bundle,
                    component::dropped_bundle,
-                   component::relative_attributes,
-                   component::incoming_damage,
-                   component::begun_casting_skills,
                    component::animation_expired,
                    component::cooldown_expired,
                    component::duration_expired,
                    component::ammo_gained,
-                   component::outgoing_strikes_component,
-                   component::outgoing_effects_component,
-                   component::incoming_strikes_component,
-                   component::incoming_effects_component,
-                   component::incoming_damage,
                    component::combat_stats_updated>();
+    utils::clear_frame_components<component::relative_attributes,
+                                  component::incoming_damage,
+                                  component::begun_casting_skills,
+                                  component::outgoing_strikes_component,
+                                  component::outgoing_effects_component,
+                                  component::incoming_strikes_component,
+                                  component::incoming_effects_component>(registry);
     registry.view<component::is_skill_trigger>().each(
         [&](component::is_skill_trigger& is_skill_trigger) {
             is_skill_trigger.already_triggered = false;
@@ -73,36 +81,55 @@ void clear_temporary_components(registry_t& registry) {
         });
 }
 
-void try_clean_entity(registry_t& registry, entity_t entity, entity_t owner_entity) {
-    if (!registry.valid(owner_entity)) {
-        registry.destroy(entity);
-    } else if (registry.any_of<component::owner_component>(owner_entity)) {
-        auto owners_owner_entity = registry.get<component::owner_component>(owner_entity).entity;
-        try_clean_entity(registry, entity, owners_owner_entity);
+void collect_descendants(registry_t& registry,
+                         entity_t entity,
+                         std::vector<entity_t>& descendants) {
+    auto children_component_ptr = registry.try_get<component::children_component>(entity);
+    if (!children_component_ptr) {
+        return;
+    }
+    for (auto child_entity : children_component_ptr->entities) {
+        descendants.emplace_back(child_entity);
+        collect_descendants(registry, child_entity, descendants);
     }
 }
 
-void clean_children_of_destroyed_owners(registry_t& registry) {
-    registry.view<component::owner_component>().each(
-        [&](entity_t entity, const component::owner_component& owner_component) {
-            try_clean_entity(registry, entity, owner_component.entity);
-        });
+void destroy_entity(registry_t& registry, entity_t entity) {
+    auto owner_component_ptr = registry.try_get<component::owner_component>(entity);
+    if (owner_component_ptr && registry.valid(owner_component_ptr->entity)) {
+        auto& owner_children_component =
+            registry.get<component::children_component>(owner_component_ptr->entity);
+        std::erase(owner_children_component.entities, entity);
+    }
+    utils::remove_effect_stack(entity, registry);
+    registry.destroy(entity);
 }
 
+// Destroys the marked entities, followed by everything they own. Owned entities are destroyed in
+// the order that a view of owner components iterates them.
 void destroy_marked_entities(registry_t& registry) {
-    bool entity_was_destroyed = false;
+    std::vector<entity_t> descendants;
     registry.view<component::destroy_entity>().each([&](entity_t entity) {
-        registry.destroy(entity);
-        entity_was_destroyed = true;
+        collect_descendants(registry, entity, descendants);
+        destroy_entity(registry, entity);
     });
-    if (entity_was_destroyed) {
-        clean_children_of_destroyed_owners(registry);
+    std::erase_if(descendants, [&](entity_t entity) { return !registry.valid(entity); });
+    if (descendants.empty()) {
+        return;
+    }
+    auto& owner_storage = registry.storage<component::owner_component>();
+    std::sort(descendants.begin(), descendants.end(), [&](entity_t lhs, entity_t rhs) {
+        return owner_storage.index(lhs) > owner_storage.index(rhs);
+    });
+    descendants.erase(std::unique(descendants.begin(), descendants.end()), descendants.end());
+    for (auto entity : descendants) {
+        destroy_entity(registry, entity);
     }
 }
 
 void tick(registry_t& registry) {
     auto& encounter =
-        registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
+        *registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
             .encounter;
     system::setup_combat_stats(registry);
 
@@ -131,30 +158,41 @@ void tick(registry_t& registry) {
             auto actor_entity = utils::get_owner(skill_entity, registry);
             auto side_effect_condition_fn = [&](const configuration::condition_t& condition) {
                 return utils::on_ammo_gain_conditions_satisfied(
-                    condition, actor_entity, is_skill.skill_configuration, registry);
+                    condition,
+                    actor_entity,
+                    utils::get_skill_configuration(is_skill, registry),
+                    registry);
             };
-            utils::apply_side_effects(registry, actor_entity, side_effect_condition_fn);
+            utils::apply_side_effects(registry,
+                                      actor_entity,
+                                      component::side_effect_trigger_t::ON_AMMO_GAIN,
+                                      side_effect_condition_fn);
         });
     registry.view<component::begun_casting_skills>().each(
         [&](entity_t actor_entity, component::begun_casting_skills& begun_casting_skills) {
             for (auto casting_skill_entity : begun_casting_skills.skill_entities) {
                 auto& skill_configuration =
-                    registry.get<component::is_skill>(casting_skill_entity).skill_configuration;
+                    utils::get_skill_configuration(casting_skill_entity, registry);
                 auto side_effect_condition_fn = [&](const configuration::condition_t& condition) {
                     return utils::on_begun_casting_conditions_satisfied(
                         condition, actor_entity, skill_configuration, registry);
                 };
-                utils::apply_side_effects(registry, actor_entity, side_effect_condition_fn);
+                utils::apply_side_effects(registry,
+                                          actor_entity,
+                                          component::side_effect_trigger_t::ON_BEGUN_CASTING,
+                                          side_effect_condition_fn);
             }
         });
     registry.view<component::is_actor>(entt::exclude<component::owner_component>)
         .each([&](entity_t actor_entity) {
             auto side_effect_condition_fn = [&](const configuration::condition_t& condition) {
-                return utils::independent_conditions_satisfied(
-                           condition, actor_entity, std::nullopt, registry)
-                    .satisfied;
+                return utils::are_independent_conditions_satisfied(
+                    condition, actor_entity, std::nullopt, registry);
             };
-            utils::apply_side_effects(registry, actor_entity, side_effect_condition_fn);
+            utils::apply_side_effects(registry,
+                                      actor_entity,
+                                      component::side_effect_trigger_t::INDEPENDENT,
+                                      side_effect_condition_fn);
         });
 
     system::dispatch_strikes(registry);
@@ -191,11 +229,115 @@ void tick(registry_t& registry) {
     clear_temporary_components(registry);
 }
 
-mru_cache_t<registry_t>::key_type convert_encounter_to_cache_key(
-    const configuration::encounter_t& encounter) {
+tick_t get_next_event_tick(registry_t& registry, const configuration::encounter_t& encounter) {
+    auto current_tick = utils::get_current_tick(registry);
+
+    tick_t condition_tick_phase = (current_tick + 1 + encounter.condition_tick_offset) % 1000;
+    tick_t next_condition_tick = current_tick + 1 + (1000 - condition_tick_phase) % 1000;
+    if ((next_condition_tick + encounter.condition_tick_offset) % 1000 != 0) {
+        // The offset wrapped around, so step through ticks like before.
+        next_condition_tick = current_tick + 1;
+    }
+    tick_t next_event_tick = std::min({next_condition_tick,
+                                       system::get_next_rotation_event_tick(registry),
+                                       system::get_next_temporal_event_tick(registry)});
+    for (auto& termination_condition : encounter.termination_conditions) {
+        if (termination_condition.type == configuration::termination_condition_t::type_t::TIME &&
+            termination_condition.time > current_tick) {
+            next_event_tick = std::min(next_event_tick, termination_condition.time);
+        }
+    }
+    if (next_event_tick <= current_tick + 1) {
+        return current_tick + 1;
+    }
+
+    // Independent side effects are evaluated on every tick, so a tick can only be skipped if none
+    // of them can trigger.
+    bool side_effect_may_trigger = false;
+    registry.view<component::is_actor>(entt::exclude<component::owner_component>)
+        .each([&](entity_t actor_entity) {
+            side_effect_may_trigger =
+                side_effect_may_trigger ||
+                utils::any_side_effect_condition_satisfied(
+                    registry,
+                    actor_entity,
+                    component::side_effect_trigger_t::INDEPENDENT,
+                    [&](const configuration::condition_t& condition) {
+                        return utils::independent_conditions_may_be_satisfied(
+                            condition, actor_entity, registry);
+                    });
+        });
+    if (side_effect_may_trigger) {
+        return current_tick + 1;
+    }
+    return next_event_tick;
+}
+
+// Fast-forwards the registry to the tick before the next event. Skipped ticks would only have
+// progressed timers and counted afk time, which is done here in bulk instead.
+void skip_idle_ticks(registry_t& registry, const configuration::encounter_t& encounter) {
+    auto current_tick = utils::get_current_tick(registry);
+    int num_idle_ticks =
+        static_cast<int>(get_next_event_tick(registry, encounter) - current_tick) - 1;
+    if (num_idle_ticks <= 0) {
+        return;
+    }
+    system::progress_idle_ticks(registry, num_idle_ticks);
+    system::audit_idle_ticks(registry, num_idle_ticks);
+    registry.ctx().get<tick_t>() += num_idle_ticks;
+}
+
+// Hashes the encounter with the first actor's skill casts left out, which is the part of the cache
+// key shared by every prefix of the first actor's rotation.
+utils::fnv1a_128_hasher_t get_encounter_hasher(const configuration::encounter_t& encounter) {
     configuration::encounter_t normalized_encounter{encounter};
     normalized_encounter.audit_offset = 0;
-    return mru_cache_t<registry_t>::djb2_hash(utils::to_string(normalized_encounter));
+    normalized_encounter.checkpoint_interval = 0;
+    normalized_encounter.actors[0].rotation.skill_casts.clear();
+
+    utils::fnv1a_128_hasher_t hasher;
+    hasher.update(utils::to_string(normalized_encounter));
+    return hasher;
+}
+
+// Returns the cache keys of every prefix of the first actor's skill casts, where the nth key
+// belongs to the encounter cut off after its first n skill casts. The skill casts are hashed on top
+// of the encounter hasher one at a time.
+std::vector<mru_cache_t<registry_t>::key_type> get_rotation_prefix_cache_keys(
+    utils::fnv1a_128_hasher_t hasher,
+    const std::vector<configuration::skill_cast_t>& skill_casts) {
+    std::vector<mru_cache_t<registry_t>::key_type> prefix_cache_keys;
+    prefix_cache_keys.reserve(skill_casts.size() + 1);
+    prefix_cache_keys.emplace_back(hasher.digest());
+    for (auto& skill_cast : skill_casts) {
+        hasher.update(skill_cast.skill).update(skill_cast.cast_time_ms);
+        prefix_cache_keys.emplace_back(hasher.digest());
+    }
+    return prefix_cache_keys;
+}
+
+// Caches a copy of the registry with the first actor's rotation cut off after the skill casts it
+// has already started, so that any rotation sharing that prefix can continue from this point.
+void cache_rotation_checkpoint(registry_t& registry,
+                               entity_t actor_entity,
+                               size_t num_skill_casts,
+                               mru_cache_t<registry_t>::key_type cache_key) {
+    auto& registry_cache = mru_cache_t<registry_t>::instance();
+    if (registry_cache.contains(cache_key)) {
+        return;
+    }
+    system::share_audit_events(registry);
+    registry_t checkpoint_registry;
+    utils::copy_registry(registry, checkpoint_registry);
+    checkpoint_registry.get<component::rotation_component>(actor_entity)
+        .rotation.skill_casts.resize(num_skill_casts);
+    auto registry_size_in_bytes = utils::get_registry_size_in_bytes(checkpoint_registry);
+    registry_cache.put(cache_key, std::move(checkpoint_registry), registry_size_in_bytes);
+    spdlog::debug("cached checkpoint after {} skill casts of {} bytes, cache holds {} of {} bytes",
+                  num_skill_casts,
+                  registry_size_in_bytes,
+                  registry_cache.get_size_in_bytes(),
+                  registry_cache.get_capacity_in_bytes());
 }
 
 bool continue_combat_loop(registry_t& registry, const configuration::encounter_t& encounter) {
@@ -263,50 +405,51 @@ bool continue_combat_loop(registry_t& registry, const configuration::encounter_t
     return true;
 }
 
-std::string combat_loop(const configuration::encounter_t& encounter, bool enable_caching) {
+// Simulates the encounter with the first actor performing the given rotation instead of its own.
+// With caching enabled, the simulation continues from the longest cached prefix of that rotation if
+// there is one. Otherwise setup_registry prepares the registry for the first tick.
+std::string simulate_encounter(
+    const configuration::encounter_t& encounter,
+    const configuration::rotation_t& rotation,
+    bool enable_caching,
+    const std::vector<mru_cache_t<registry_t>::key_type>& prefix_cache_keys,
+    const std::function<void(registry_t&)>& setup_registry) {
     auto& registry_cache = mru_cache_t<registry_t>::instance();
 
     registry_t registry;
     if (enable_caching) {
-        auto actor = encounter.actors[0];
-        size_t max_depth = actor.rotation.skill_casts.size();
-
         bool is_cache_miss = true;
-        configuration::encounter_t current_encounter{encounter};
-        for (size_t depth = 0; depth < max_depth && is_cache_miss; ++depth) {
-            if (depth > 0) {
-                current_encounter.actors[0].rotation.skill_casts.pop_back();
-            }
-
-            auto cache_key = convert_encounter_to_cache_key(current_encounter);
-            if (registry_cache.contains(cache_key)) {
-                registry.clear();
-                utils::copy_registry(registry_cache.get(cache_key), registry);
+        for (size_t num_skill_casts = rotation.skill_casts.size(); num_skill_casts > 0;
+             --num_skill_casts) {
+            if (registry_cache.visit(prefix_cache_keys[num_skill_casts],
+                                     [&](const registry_t& cached_registry) {
+                                         registry.clear();
+                                         utils::copy_registry(cached_registry, registry);
+                                     })) {
                 is_cache_miss = false;
                 break;
             }
         }
         if (is_cache_miss) {
-            registry.ctx().emplace<tick_t>(0);
-            system::setup_encounter(registry, encounter);
+            setup_registry(registry);
         } else {
             for (auto&& [actor_entity] :
                  registry.view<component::is_actor>(entt::exclude<component::owner_component>)
                      .each()) {
-                if (utils::get_entity_name(actor_entity, registry) != actor.name) {
+                if (utils::get_entity_name(actor_entity, registry) != encounter.actors[0].name) {
                     continue;
                 }
                 auto& existing_rotation_component =
                     registry.get<component::rotation_component>(actor_entity);
                 auto existing_rotation_size =
                     existing_rotation_component.rotation.skill_casts.size();
-                if (existing_rotation_size == actor.rotation.skill_casts.size()) {
+                if (existing_rotation_size == rotation.skill_casts.size()) {
                     break;
                 }
                 registry.remove<component::no_more_rotation>(actor_entity);
                 std::transform(
-                    encounter.actors[0].rotation.skill_casts.begin() + existing_rotation_size,
-                    encounter.actors[0].rotation.skill_casts.end(),
+                    rotation.skill_casts.begin() + existing_rotation_size,
+                    rotation.skill_casts.end(),
                     std::back_inserter(existing_rotation_component.rotation.skill_casts),
                     [](const configuration::skill_cast_t& skill_cast) {
                         return actor::skill_cast_t{skill_cast.skill, skill_cast.cast_time_ms};
@@ -315,16 +458,52 @@ std::string combat_loop(const configuration::encounter_t& encounter, bool enable
             }
         }
     } else {
-        registry.ctx().emplace<tick_t>(0);
-        system::setup_encounter(registry, encounter);
+        setup_registry(registry);
+    }
+
+    // Checkpoints are only taken while the first actor works through its rotation for the first
+    // time, since a repeating rotation no longer matches the prefix its cache key was hashed from.
+    entity_t checkpoint_actor_entity = entt::null;
+    int last_checkpoint_idx = 0;
+    if (enable_caching && encounter.checkpoint_interval > 0) {
+        for (auto&& [actor_entity, rotation_component] :
+             registry
+                 .view<component::is_actor, component::rotation_component>(
+                     entt::exclude<component::owner_component>)
+                 .each()) {
+            if (utils::get_entity_name(actor_entity, registry) == encounter.actors[0].name &&
+                !rotation_component.repeat) {
+                checkpoint_actor_entity = actor_entity;
+                last_checkpoint_idx = rotation_component.current_idx;
+                break;
+            }
+        }
     }
 
     std::string result;
     try {
         system::setup_combat_stats(registry);
         while (continue_combat_loop(registry, encounter)) {
+            skip_idle_ticks(registry, encounter);
             registry.ctx().get<tick_t>() += 1;
             tick(registry);
+
+            if (checkpoint_actor_entity == entt::null ||
+                !registry.all_of<component::rotation_component>(checkpoint_actor_entity)) {
+                continue;
+            }
+            // Rotations advance by at most one skill cast per tick, so no index can be missed.
+            int current_idx =
+                registry.get<component::rotation_component>(checkpoint_actor_entity).current_idx;
+            if (current_idx != last_checkpoint_idx &&
+                current_idx % encounter.checkpoint_interval == 0 &&
+                current_idx < static_cast<int>(prefix_cache_keys.size()) - 1) {
+                cache_rotation_checkpoint(registry,
+                                          checkpoint_actor_entity,
+                                          static_cast<size_t>(current_idx),
+                                          prefix_cache_keys[current_idx]);
+            }
+            last_checkpoint_idx = current_idx;
         }
         result = utils::to_string(system::get_audit_report(registry, encounter.audit_offset));
     } catch (std::exception& e) {
@@ -333,11 +512,133 @@ std::string combat_loop(const configuration::encounter_t& encounter, bool enable
             utils::to_string(system::get_audit_report(registry, encounter.audit_offset, e.what()));
     }
 
-    auto cache_key = convert_encounter_to_cache_key(encounter);
+    auto cache_key = prefix_cache_keys.back();
     if (!registry_cache.contains(cache_key)) {
-        registry_cache.put(cache_key, std::move(registry));
+        system::share_audit_events(registry);
+        auto registry_size_in_bytes = utils::get_registry_size_in_bytes(registry);
+        registry_cache.put(cache_key, std::move(registry), registry_size_in_bytes);
+        spdlog::debug("cached registry of {} bytes, cache holds {} of {} bytes",
+                      registry_size_in_bytes,
+                      registry_cache.get_size_in_bytes(),
+                      registry_cache.get_capacity_in_bytes());
     }
     return result;
 }
 
+// Identical encounters that are being simulated at the same time are only simulated once, since
+// the registry cache only helps after a simulation has finished. The audit offset is left out of
+// the cache key but changes the report, so it is added to the key here. Without caching, every
+// request gets a simulation of its own.
+std::string simulate_encounter_once(
+    const configuration::encounter_t& encounter,
+    const configuration::rotation_t& rotation,
+    bool enable_caching,
+    const std::vector<mru_cache_t<registry_t>::key_type>& prefix_cache_keys,
+    const std::function<void(registry_t&)>& setup_registry) {
+    auto simulate = [&] {
+        return simulate_encounter(
+            encounter, rotation, enable_caching, prefix_cache_keys, setup_registry);
+    };
+    if (!enable_caching) {
+        return simulate();
+    }
+    auto cache_key = prefix_cache_keys.back();
+    auto in_flight_key = utils::fnv1a_128_hasher_t{}
+                             .update(cache_key.high)
+                             .update(cache_key.low)
+                             .update(encounter.audit_offset)
+                             .digest();
+    return single_flight_t<std::string>::instance().run(in_flight_key, simulate);
+}
+
+std::string combat_loop(const configuration::encounter_t& encounter, bool enable_caching) {
+    auto& rotation = encounter.actors[0].rotation;
+    return simulate_encounter_once(
+        encounter,
+        rotation,
+        enable_caching,
+        get_rotation_prefix_cache_keys(get_encounter_hasher(encounter), rotation.skill_casts),
+        [&](registry_t& registry) {
+            registry.ctx().emplace<tick_t>(0);
+            system::setup_encounter(registry, encounter);
+        });
+}
+
+std::vector<std::string> combat_loop_batch(const configuration::encounter_t& encounter,
+                                           const std::vector<configuration::rotation_t>& rotations,
+                                           bool enable_caching,
+                                           int threads) {
+    if (rotations.empty()) {
+        return {};
+    }
+
+    // The encounter is set up once, with the first non-empty rotation so that the first actor's
+    // rotation component is created where setup_encounter would create it. Every rotation then
+    // starts from a copy of this registry with the first actor's rotation replaced.
+    configuration::encounter_t base_encounter{encounter};
+    auto non_empty_rotation = std::find_if(
+        rotations.begin(), rotations.end(), [](const configuration::rotation_t& rotation) {
+            return !rotation.skill_casts.empty();
+        });
+    base_encounter.actors[0].rotation =
+        non_empty_rotation != rotations.end() ? *non_empty_rotation : rotations[0];
+    registry_t base_registry;
+    base_registry.ctx().emplace<tick_t>(0);
+    system::setup_encounter(base_registry, base_encounter);
+
+    entity_t first_actor_entity = entt::null;
+    for (auto&& [actor_entity] :
+         base_registry.view<component::is_actor>(entt::exclude<component::owner_component>)
+             .each()) {
+        if (utils::get_entity_name(actor_entity, base_registry) == encounter.actors[0].name) {
+            first_actor_entity = actor_entity;
+            break;
+        }
+    }
+
+    // The repeat flag is part of the serialized encounter, so there is one encounter hasher per
+    // value of it.
+    std::array<utils::fnv1a_128_hasher_t, 2> encounter_hashers;
+    for (bool repeat : {false, true}) {
+        base_encounter.actors[0].rotation.repeat = repeat;
+        encounter_hashers[repeat] = get_encounter_hasher(base_encounter);
+    }
+
+    std::vector<std::string> results(rotations.size());
+    std::vector<std::exception_ptr> errors(rotations.size());
+    std::atomic<size_t> next_rotation_idx = 0;
+    auto simulate_rotations = [&] {
+        for (size_t idx = next_rotation_idx++; idx < rotations.size(); idx = next_rotation_idx++) {
+            auto& rotation = rotations[idx];
+            try {
+                results[idx] = simulate_encounter_once(
+                    encounter,
+                    rotation,
+                    enable_caching,
+                    get_rotation_prefix_cache_keys(encounter_hashers[rotation.repeat],
+                                                   rotation.skill_casts),
+                    [&](registry_t& registry) {
+                        utils::copy_registry(base_registry, registry);
+                        system::setup_rotation(registry, first_actor_entity, rotation);
+                    });
+            } catch (...) {
+                errors[idx] = std::current_exception();
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> workers;
+        for (int i = 1; i < std::min(threads, static_cast<int>(rotations.size())); ++i) {
+            workers.emplace_back(simulate_rotations);
+        }
+        simulate_rotations();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return results;
+}
+
 }  // namespace gw2combat
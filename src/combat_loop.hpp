@@ -12,6 +12,15 @@ extern void tick(registry_t& registry);
 extern std::string combat_loop(const configuration::encounter_t& encounter_configuration,
                                bool enable_caching = false);
 
+// Simulates the encounter once per rotation, with the first actor performing that rotation, on up
+// to the given number of threads. The encounter is only set up once for all of them. Returns the
+// audit reports in the order of the rotations.
+extern std::vector<std::string> combat_loop_batch(
+    const configuration::encounter_t& encounter_configuration,
+    const std::vector<configuration::rotation_t>& rotations,
+    bool enable_caching = false,
+    int threads = 1);
+
 }  // namespace gw2combat
 
 #endif  // GW2COMBAT_COMBAT_LOOP_HPP
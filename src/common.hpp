@@ -19,4 +19,18 @@ using registry_t = entt::basic_registry<entity_t>;
 
 }  // namespace gw2combat
 
+// Traces of individual simulation events. They are compiled out unless SPDLOG_ACTIVE_LEVEL is
+// lowered to SPDLOG_LEVEL_TRACE, as debug builds do, and even then their arguments are only
+// evaluated while the trace level is enabled at runtime.
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define GW2COMBAT_TRACE(...)                              \
+    do {                                                  \
+        if (spdlog::should_log(spdlog::level::trace)) {   \
+            SPDLOG_TRACE(__VA_ARGS__);                    \
+        }                                                 \
+    } while (false)
+#else
+#define GW2COMBAT_TRACE(...) (void)0
+#endif
+
 #endif  // GW2COMBAT_COMMON_HPP
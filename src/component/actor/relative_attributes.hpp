@@ -9,17 +9,52 @@ namespace gw2combat::component {
 
 struct relative_attributes {
     [[nodiscard]] inline double get(entity_t target_entity, actor::attribute_t attribute) const {
-        return entity_and_attribute_to_value_map.at(target_entity).at(attribute);
+        return get(target_entity).at(attribute);
     }
     inline double set(entity_t target_entity, actor::attribute_t attribute, double value) {
-        return entity_and_attribute_to_value_map[target_entity][attribute] = value;
+        return get_or_emplace(target_entity)[attribute] = value;
     }
 
-    std::map<entity_t, std::map<actor::attribute_t, double>> entity_and_attribute_to_value_map;
+    [[nodiscard]] inline bool contains(entity_t target_entity) const {
+        return std::any_of(entity_and_attribute_values.begin(),
+                           entity_and_attribute_values.end(),
+                           [&](auto&& entry) { return entry.first == target_entity; });
+    }
+    [[nodiscard]] inline const actor::attribute_values_t& get(entity_t target_entity) const {
+        for (auto& [entity, attribute_values] : entity_and_attribute_values) {
+            if (entity == target_entity) {
+                return attribute_values;
+            }
+        }
+        throw std::out_of_range("relative_attributes::get");
+    }
+    inline actor::attribute_values_t& get_or_emplace(entity_t target_entity) {
+        for (auto& [entity, attribute_values] : entity_and_attribute_values) {
+            if (entity == target_entity) {
+                return attribute_values;
+            }
+        }
+        return entity_and_attribute_values.emplace_back(target_entity, actor::attribute_values_t{})
+            .second;
+    }
+
+    // One row per other actor. There are only ever a handful of actors, so a linear scan beats a
+    // tree lookup.
+    std::vector<std::pair<entity_t, actor::attribute_values_t>> entity_and_attribute_values;
+};
+
+// relative_attributes as of the last time they were calculated, together with a signature of the
+// owning actor's inputs (modifiers, effects, cooldowns, equipment, counters) at that time. A row
+// only needs to be recalculated once the signature of either of its actors changes.
+struct relative_attributes_cache {
+    relative_attributes attributes;
+    std::vector<std::uint64_t> inputs_signature;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(relative_attributes,
-                                                entity_and_attribute_to_value_map)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(relative_attributes, entity_and_attribute_values)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(relative_attributes_cache,
+                                                attributes,
+                                                inputs_signature)
 
 }  // namespace gw2combat::component
 
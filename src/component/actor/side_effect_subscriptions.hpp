@@ -0,0 +1,38 @@
+#ifndef GW2COMBAT_COMPONENT_ACTOR_SIDE_EFFECT_SUBSCRIPTIONS_HPP
+#define GW2COMBAT_COMPONENT_ACTOR_SIDE_EFFECT_SUBSCRIPTIONS_HPP
+
+#include "common.hpp"
+
+#include <array>
+#include <bitset>
+#include <vector>
+
+namespace gw2combat::component {
+
+// The events that side effects are applied on. Critical strikes also fire ON_STRIKE.
+enum class side_effect_trigger_t : std::uint8_t
+{
+    INDEPENDENT,
+    ON_STRIKE,
+    ON_CRITICAL_STRIKE,
+    ON_EFFECT_APPLICATION,
+    ON_BEGUN_CASTING,
+    ON_FINISHED_CASTING,
+    ON_AMMO_GAIN,
+};
+
+inline constexpr std::size_t side_effect_trigger_count = 7;
+
+using side_effect_triggers_t = std::bitset<side_effect_trigger_count>;
+
+// The side effect holder entities owned by an actor, by the triggers that their conditions can
+// fire on, so that an event only visits the side effects that can fire for it. Holders are added
+// when they are created, and entries of destroyed holders are dropped the next time their trigger
+// fires.
+struct side_effect_subscriptions {
+    std::array<std::vector<entity_t>, side_effect_trigger_count> holders_by_trigger;
+};
+
+}  // namespace gw2combat::component
+
+#endif  // GW2COMBAT_COMPONENT_ACTOR_SIDE_EFFECT_SUBSCRIPTIONS_HPP
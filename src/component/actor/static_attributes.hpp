@@ -6,7 +6,7 @@
 namespace gw2combat::component {
 
 struct static_attributes {
-    std::map<actor::attribute_t, double> attribute_value_map;
+    actor::attribute_values_t attribute_value_map;
 };
 
 }  // namespace gw2combat::component
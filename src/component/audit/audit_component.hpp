@@ -3,6 +3,8 @@
 
 #include "common.hpp"
 
+#include <memory>
+
 #include "configuration/audit.hpp"
 
 #include "audit/tick_event.hpp"
@@ -13,6 +15,10 @@ struct audit_component {
     configuration::audit_t audit_configuration;
     std::vector<audit::tick_event_t> events;
     std::map<std::string, int> afk_ticks_by_actor;
+
+    // Events recorded before the registry was cached, in order and followed by events. Copies of
+    // the registry share them instead of copying every event.
+    std::vector<std::shared_ptr<const std::vector<audit::tick_event_t>>> shared_events;
 };
 
 }  // namespace gw2combat::component
@@ -1,6 +1,8 @@
 #ifndef GW2COMBAT_COMPONENT_COUNTER_IS_COUNTER_HPP
 #define GW2COMBAT_COMPONENT_COUNTER_IS_COUNTER_HPP
 
+#include "symbol_table.hpp"
+
 #include "configuration/counter_configuration.hpp"
 
 namespace gw2combat::component {
@@ -8,9 +10,13 @@ namespace gw2combat::component {
 struct is_counter {
     int value = 0;
     configuration::counter_configuration_t counter_configuration;
+    symbol_t counter_id = symbol_table_t::invalid_symbol;
 };
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(is_counter, value, counter_configuration)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(is_counter,
+                                                value,
+                                                counter_configuration,
+                                                counter_id)
 
 }  // namespace gw2combat::component
 
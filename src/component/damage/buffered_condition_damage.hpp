@@ -3,15 +3,16 @@
 
 #include "common.hpp"
 
+#include "symbol_table.hpp"
+
 #include "actor/effect.hpp"
-#include "actor/skill.hpp"
 
 namespace gw2combat::component {
 
 struct condition_damage_t {
     entity_t effect_source_entity;
     actor::effect_t effect;
-    actor::skill_t source_skill;
+    symbol_t source_skill;
     double damage;
 };
 
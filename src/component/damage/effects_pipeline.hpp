@@ -1,15 +1,16 @@
 #ifndef GW2COMBAT_COMPONENT_DAMAGE_EFFECTS_PIPELINE_HPP
 #define GW2COMBAT_COMPONENT_DAMAGE_EFFECTS_PIPELINE_HPP
 
+#include "skill_configuration_table.hpp"
+
 #include "actor/effect.hpp"
-#include "actor/unique_effect.hpp"
 
-#include "configuration/condition.hpp"
 #include "configuration/effect_application.hpp"
-#include "configuration/unique_effect.hpp"
 
 namespace gw2combat::component {
 
+// Refers to its configuration, which holds the condition and unique effect of the application, by
+// the skill and action it was configured for, and only carries the data of this application.
 struct effect_application_t {
     enum class direction_t : std::uint8_t
     {
@@ -20,11 +21,19 @@ struct effect_application_t {
         OUTGOING,
     };
 
-    configuration::condition_t condition;
+    enum class skill_action_t : std::uint8_t
+    {
+        INVALID,
+
+        STRIKE,
+        PULSE,
+    };
+
+    skill_handle_t skill_handle = skill_configuration_table_t::invalid_handle;
+    skill_action_t skill_action = skill_action_t::INVALID;
+    std::uint32_t application_idx = 0;
 
-    actor::skill_t source_skill;
     actor::effect_t effect = actor::effect_t::INVALID;
-    configuration::unique_effect_t unique_effect;
     direction_t direction = direction_t::INVALID;
     int base_duration_ms = 0;
     int num_stacks = 1;
@@ -65,10 +74,18 @@ NLOHMANN_JSON_SERIALIZE_ENUM(effect_application_t::direction_t,
                                  {effect_application_t::direction_t::TEAM, "TEAM"},
                                  {effect_application_t::direction_t::OUTGOING, "OUTGOING"},
                              })
+NLOHMANN_JSON_SERIALIZE_ENUM(effect_application_t::skill_action_t,
+                             {
+                                 {effect_application_t::skill_action_t::INVALID, "invalid"},
+
+                                 {effect_application_t::skill_action_t::STRIKE, "STRIKE"},
+                                 {effect_application_t::skill_action_t::PULSE, "PULSE"},
+                             })
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(effect_application_t,
-                                                condition,
+                                                skill_handle,
+                                                skill_action,
+                                                application_idx,
                                                 effect,
-                                                unique_effect,
                                                 direction,
                                                 base_duration_ms,
                                                 num_stacks,
@@ -2,9 +2,9 @@
 #define GW2COMBAT_COMPONENT_DAMAGE_INCOMING_DAMAGE_HPP
 
 #include "common.hpp"
+#include "symbol_table.hpp"
 
 #include "actor/effect.hpp"
-#include "actor/skill.hpp"
 
 namespace gw2combat::component {
 
@@ -12,7 +12,7 @@ struct incoming_damage_event {
     tick_t tick = 0;
     entity_t source_entity = entt::tombstone;
     actor::effect_t effect = actor::effect_t::INVALID;
-    actor::skill_t skill;
+    symbol_t skill = symbol_table_t::invalid_symbol;
     double value = 0.0;
 };
 
@@ -0,0 +1,35 @@
+#ifndef GW2COMBAT_COMPONENT_EFFECT_EFFECT_STACKS_HPP
+#define GW2COMBAT_COMPONENT_EFFECT_EFFECT_STACKS_HPP
+
+#include "common.hpp"
+
+#include <map>
+#include <vector>
+
+#include "symbol_table.hpp"
+
+#include "actor/effect.hpp"
+
+namespace gw2combat::component {
+
+// The stacks of an effect on an actor, stored column by column in the order they were added.
+// Stack entities only carry what views over effects need, so the source of a stack lives here and
+// is read through utils::get_effect_source_actor and utils::get_effect_source_skill.
+struct effect_stack_group_t {
+    std::vector<entity_t> entities;
+    std::vector<entity_t> source_actors;
+    std::vector<symbol_t> source_skills;
+};
+
+// Index of the effect and unique effect stacks that an actor owns, in the order they were added.
+// Unique effect stacks are keyed by unique effect id and source actor. Stacks are added by
+// utils::add_effect_to_actor and utils::add_unique_effect_to_actor and removed right before the
+// stack entity is destroyed, so conditions never have to scan every effect in the registry.
+struct effect_stacks {
+    std::map<actor::effect_t, effect_stack_group_t> effects;
+    std::map<std::pair<symbol_t, entity_t>, std::vector<entity_t>> unique_effects;
+};
+
+}  // namespace gw2combat::component
+
+#endif  // GW2COMBAT_COMPONENT_EFFECT_EFFECT_STACKS_HPP
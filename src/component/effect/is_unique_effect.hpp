@@ -1,12 +1,15 @@
 #ifndef GW2COMBAT_COMPONENT_EFFECT_IS_UNIQUE_EFFECT_HPP
 #define GW2COMBAT_COMPONENT_EFFECT_IS_UNIQUE_EFFECT_HPP
 
+#include "symbol_table.hpp"
+
 #include "configuration/unique_effect.hpp"
 
 namespace gw2combat::component {
 
 struct is_unique_effect {
     configuration::unique_effect_t unique_effect;
+    symbol_t unique_effect_id = symbol_table_t::invalid_symbol;
 };
 
 }  // namespace gw2combat::component
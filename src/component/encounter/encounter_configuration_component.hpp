@@ -1,12 +1,15 @@
 #ifndef GW2COMBAT_COMPONENT_ENCOUNTER_ENCOUNTER_CONFIGURATION_COMPONENT_HPP
 #define GW2COMBAT_COMPONENT_ENCOUNTER_ENCOUNTER_CONFIGURATION_COMPONENT_HPP
 
+#include <memory>
+
 #include "configuration/encounter.hpp"
 
 namespace gw2combat::component {
 
+// Shared between copies of a registry, since the encounter never changes during a simulation.
 struct encounter_configuration_component {
-    configuration::encounter_t encounter;
+    std::shared_ptr<const configuration::encounter_t> encounter;
 };
 
 }  // namespace gw2combat::component
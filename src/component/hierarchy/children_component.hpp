@@ -0,0 +1,15 @@
+#ifndef GW2COMBAT_COMPONENT_HIERARCHY_CHILDREN_COMPONENT_HPP
+#define GW2COMBAT_COMPONENT_HIERARCHY_CHILDREN_COMPONENT_HPP
+
+#include "common.hpp"
+
+namespace gw2combat::component {
+
+// The entities that are directly owned by this entity, which are destroyed along with it.
+struct children_component {
+    std::vector<entity_t> entities;
+};
+
+}  // namespace gw2combat::component
+
+#endif  // GW2COMBAT_COMPONENT_HIERARCHY_CHILDREN_COMPONENT_HPP
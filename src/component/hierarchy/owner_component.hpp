@@ -7,6 +7,8 @@ namespace gw2combat::component {
 
 struct owner_component {
     entity_t entity;
+    // The root of the owner chain, which utils::get_owner returns. Set by utils::set_owner.
+    entity_t root_entity = entt::null;
 };
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(owner_component, entity)
@@ -1,12 +1,15 @@
 #ifndef GW2COMBAT_COMPONENT_SKILL_IS_CONDITIONAL_SKILL_GROUP_HPP
 #define GW2COMBAT_COMPONENT_SKILL_IS_CONDITIONAL_SKILL_GROUP_HPP
 
+#include "symbol_table.hpp"
+
 #include "configuration/skill.hpp"
 
 namespace gw2combat::component {
 
 struct is_conditional_skill_group {
     configuration::conditional_skill_group_t conditional_skill_group_configuration;
+    symbol_t skill_id = symbol_table_t::invalid_symbol;
 };
 
 struct is_part_of_conditional_skill_group {
@@ -1,12 +1,16 @@
 #ifndef GW2COMBAT_COMPONENT_SKILL_IS_SKILL_HPP
 #define GW2COMBAT_COMPONENT_SKILL_IS_SKILL_HPP
 
-#include "configuration/skill.hpp"
+#include "skill_configuration_table.hpp"
+#include "symbol_table.hpp"
 
 namespace gw2combat::component {
 
+// The configuration lives in the encounter's skill configuration table, which copies of a registry
+// share.
 struct is_skill {
-    configuration::skill_t skill_configuration;
+    skill_handle_t skill_handle = skill_configuration_table_t::invalid_handle;
+    symbol_t skill_id = symbol_table_t::invalid_symbol;
 };
 
 }  // namespace gw2combat::component
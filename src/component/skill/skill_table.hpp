@@ -0,0 +1,21 @@
+#ifndef GW2COMBAT_COMPONENT_SKILL_SKILL_TABLE_HPP
+#define GW2COMBAT_COMPONENT_SKILL_SKILL_TABLE_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include "symbol_table.hpp"
+
+namespace gw2combat::component {
+
+// The skill and conditional skill group entities of an actor by skill id, so that they are looked
+// up without scanning every skill in the registry. An actor can hold several skills with the same
+// key but different configurations, which are kept in the order they were added.
+struct skill_table {
+    std::unordered_map<symbol_t, std::vector<entity_t>> skill_entities;
+    std::unordered_map<symbol_t, entity_t> conditional_skill_group_entities;
+};
+
+}  // namespace gw2combat::component
+
+#endif  // GW2COMBAT_COMPONENT_SKILL_SKILL_TABLE_HPP
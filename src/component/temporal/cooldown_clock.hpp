@@ -0,0 +1,20 @@
+#ifndef GW2COMBAT_COMPONENT_TEMPORAL_COOLDOWN_CLOCK_HPP
+#define GW2COMBAT_COMPONENT_TEMPORAL_COOLDOWN_CLOCK_HPP
+
+#include "common.hpp"
+
+namespace gw2combat::component {
+
+// The number of ticks that the cooldowns owned by an actor have progressed without and with
+// alacrity, and whether the actor had alacrity the last time they progressed. The progress of a
+// cooldown is measured against the clock of its owner actor.
+struct cooldown_clock {
+    std::array<std::int64_t, 2> steps = {0, 0};
+    bool has_alacrity = false;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(cooldown_clock, steps, has_alacrity)
+
+}  // namespace gw2combat::component
+
+#endif  // GW2COMBAT_COMPONENT_TEMPORAL_COOLDOWN_CLOCK_HPP
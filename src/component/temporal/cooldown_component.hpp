@@ -5,14 +5,21 @@
 
 namespace gw2combat::component {
 
+// Cooldowns progress in the first element without alacrity and in the second with it. Progress is
+// the number of steps that the cooldown clock of the owner actor took since the start steps, and
+// is read through utils::get_cooldown_progress.
 struct cooldown_component {
     std::array<int, 2> duration;
-    std::array<int, 2> progress = {0, 0};
+    std::array<std::int64_t, 2> start_steps = {0, 0};
+    std::int64_t expiry_step = 0;
 };
 
 struct cooldown_expired {};
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(cooldown_component, duration, progress)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(cooldown_component,
+                                                duration,
+                                                start_steps,
+                                                expiry_step)
 
 }  // namespace gw2combat::component
 
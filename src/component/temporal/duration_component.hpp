@@ -5,14 +5,16 @@
 
 namespace gw2combat::component {
 
+// Progress is the number of steps that the duration clock took since the start step, and is read
+// through utils::get_duration_progress.
 struct duration_component {
     int duration = 0;
-    int progress = 0;
+    std::int64_t start_step = 0;
 };
 
 struct duration_expired {};
 
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(duration_component, duration, progress)
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(duration_component, duration, start_step)
 
 }  // namespace gw2combat::component
 
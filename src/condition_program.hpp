@@ -0,0 +1,75 @@
+#ifndef GW2COMBAT_CONDITION_PROGRAM_HPP
+#define GW2COMBAT_CONDITION_PROGRAM_HPP
+
+#include <vector>
+
+#include "common.hpp"
+
+#include "configuration/condition.hpp"
+
+namespace gw2combat {
+
+// A condition_t compiled into a flat list of instructions, one per stage independent predicate
+// that the condition actually sets. Skill, counter and unique effect keys are resolved to symbols
+// of the registry the program was compiled for. The predicates of a condition form a block, which
+// is satisfied when all of its instructions are, and the not, or and and composites run the blocks
+// of their child conditions with short-circuiting.
+//
+// Instructions point into the condition they were compiled from, which has to outlive them, so
+// programs are neither copied nor moved once compiled.
+struct condition_program_t {
+    enum class opcode_t : std::uint8_t
+    {
+        WEAPON,
+        WEAPON_SET,
+        BUNDLE,
+        UNIQUE_EFFECT_ON_SOURCE,
+        EFFECT_ON_SOURCE,
+        UNIQUE_EFFECT_ON_TARGET,
+        UNIQUE_EFFECT_ON_TARGET_BY_SOURCE,
+        EFFECT_ON_TARGET,
+        SKILL_OFF_COOLDOWN,
+        INVALID_THRESHOLD,
+        RANDOM_NUMBER_THRESHOLD,
+        HEALTH_PCT_THRESHOLD,
+        COUNTER_VALUE_THRESHOLD,
+        NOT,
+        OR,
+        AND,
+    };
+
+    struct instruction_t {
+        opcode_t opcode;
+        // The resolved symbol or effect, or the index of the first child block of a composite.
+        std::uint32_t operand = 0;
+        // The number of child blocks of a composite.
+        std::uint32_t size = 0;
+        // The condition that set the predicate, for operands that need no resolving and for
+        // failure reasons.
+        const configuration::condition_t* condition = nullptr;
+    };
+
+    struct block_t {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;
+        const configuration::condition_t* condition = nullptr;
+    };
+
+    condition_program_t() = default;
+    condition_program_t(const condition_program_t&) = delete;
+    condition_program_t& operator=(const condition_program_t&) = delete;
+
+    // The copy of the condition that shared programs are compiled from.
+    configuration::condition_t condition;
+
+    block_t root;
+    std::vector<block_t> child_blocks;
+    std::vector<instruction_t> instructions;
+
+    bool is_stage_dependent = false;
+    bool has_unpredictable_threshold = false;
+};
+
+}  // namespace gw2combat
+
+#endif  // GW2COMBAT_CONDITION_PROGRAM_HPP
@@ -3,6 +3,8 @@
 
 #include "common.hpp"
 
+#include <memory>
+
 #include "actor/bundle.hpp"
 #include "actor/effect.hpp"
 #include "actor/skill.hpp"
@@ -11,6 +13,12 @@
 
 #include "threshold.hpp"
 
+namespace gw2combat {
+
+struct condition_program_t;
+
+}  // namespace gw2combat
+
 namespace gw2combat::configuration {
 
 struct condition_t {
@@ -58,6 +66,9 @@ struct condition_t {
 
     // on-skill-off-cooldown
     std::optional<actor::skill_t> only_applies_on_ammo_gain_of_skill = std::nullopt;
+
+    // Not serialized. Set by utils::compile_conditions and shared by copies of the condition.
+    std::shared_ptr<const condition_program_t> program = nullptr;
 };
 
 static inline void to_json(nlohmann::json& nlohmann_json_j, const condition_t& nlohmann_json_t) {
@@ -57,6 +57,7 @@ struct encounter_t {
     weapon_strength_mode_t weapon_strength_mode = weapon_strength_mode_t::MEAN;
     critical_strike_mode_t critical_strike_mode = critical_strike_mode_t::MEAN;
     bool enable_caching = true;
+    int checkpoint_interval = 0;
 };
 
 NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(actor_t,
@@ -88,7 +89,8 @@ NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(encounter_t,
                                                 audit_offset,
                                                 weapon_strength_mode,
                                                 critical_strike_mode,
-                                                enable_caching)
+                                                enable_caching,
+                                                checkpoint_interval)
 
 }  // namespace gw2combat::configuration
 
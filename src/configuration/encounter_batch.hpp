@@ -0,0 +1,21 @@
+#ifndef GW2COMBAT_CONFIGURATION_ENCOUNTER_BATCH_HPP
+#define GW2COMBAT_CONFIGURATION_ENCOUNTER_BATCH_HPP
+
+#include "common.hpp"
+
+#include "encounter.hpp"
+#include "rotation.hpp"
+
+namespace gw2combat::configuration {
+
+// One encounter simulated once per rotation, with the first actor's rotation replaced by each.
+struct encounter_batch_t {
+    encounter_t encounter;
+    std::vector<rotation_t> rotations;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(encounter_batch_t, encounter, rotations)
+
+}  // namespace gw2combat::configuration
+
+#endif  // GW2COMBAT_CONFIGURATION_ENCOUNTER_BATCH_HPP
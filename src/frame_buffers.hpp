@@ -0,0 +1,57 @@
+#ifndef GW2COMBAT_FRAME_BUFFERS_HPP
+#define GW2COMBAT_FRAME_BUFFERS_HPP
+
+#include <tuple>
+#include <vector>
+
+#include "common.hpp"
+
+#include "component/damage/buffered_condition_damage.hpp"
+#include "component/damage/effects_pipeline.hpp"
+#include "component/damage/incoming_damage.hpp"
+#include "component/damage/strikes_pipeline.hpp"
+
+#include "actor/attributes.hpp"
+
+namespace gw2combat {
+
+// Spare buffers for the components that only live for a tick. When such a component is cleared,
+// its buffer is emptied and kept here with its capacity, and the next component of the same type
+// that is created takes it over, so that steady-state ticks don't allocate any buffers. Every
+// registry owns its own spare buffers in its context, which copies of the registry don't share.
+struct frame_buffers_t {
+    // Moves a spare buffer into the empty buffer of a component that was just created.
+    template <typename T>
+    void acquire(std::vector<T>& buffer) {
+        auto& buffers = std::get<std::vector<std::vector<T>>>(spare_buffers);
+        if (buffers.empty()) {
+            return;
+        }
+        buffer = std::move(buffers.back());
+        buffers.pop_back();
+    }
+
+    // Empties the buffer of a component that is about to be removed and keeps it as a spare.
+    template <typename T>
+    void release(std::vector<T>& buffer) {
+        if (buffer.capacity() == 0) {
+            return;
+        }
+        buffer.clear();
+        std::get<std::vector<std::vector<T>>>(spare_buffers).emplace_back(std::move(buffer));
+    }
+
+    std::tuple<std::vector<std::vector<entity_t>>,
+               std::vector<std::vector<std::pair<entity_t, actor::attribute_values_t>>>,
+               std::vector<std::vector<component::strike_t>>,
+               std::vector<std::vector<component::incoming_strike>>,
+               std::vector<std::vector<component::effect_application_t>>,
+               std::vector<std::vector<component::incoming_effect_application>>,
+               std::vector<std::vector<component::incoming_damage_event>>,
+               std::vector<std::vector<component::condition_damage_t>>>
+        spare_buffers;
+};
+
+}  // namespace gw2combat
+
+#endif  // GW2COMBAT_FRAME_BUFFERS_HPP
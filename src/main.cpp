@@ -11,6 +11,7 @@
 
 #include "spdlog/spdlog.h"
 #include "utils/io_utils.hpp"
+#include "utils/log_utils.hpp"
 
 #include "argparse/argparse.hpp"
 
@@ -34,16 +35,16 @@ int main(int argc, char** argv) {
         .default_value(4096)
         .scan<'i', int>()
         .help("Cache size in MiB. Only applicable in server mode.");
-    parser.add_argument("--average-registry-size")
-        .default_value(64)
-        .scan<'i', int>()
-        .help("Average registry size in MiB. Only applicable in server mode.");
     parser.add_argument("--encounter")
         .default_value(std::string{"resources/encounter.json"})
         .help("Path to encounter file. Only applicable in default mode.");
     parser.add_argument("--audit-path")
         .default_value(std::string{"audit.json"})
         .help("Path to audit file. Only applicable in default mode.");
+    parser.add_argument("--trace")
+        .default_value(false)
+        .implicit_value(true)
+        .help("Log every simulation event. Only available in debug builds.");
 
     try {
         parser.parse_args(argc, argv);
@@ -53,6 +54,10 @@ int main(int argc, char** argv) {
         std::exit(1);
     }
 
+    if (parser.get<bool>("--trace")) {
+        utils::enable_tracing();
+    }
+
     bool server_mode = parser.is_used("--server");
     if (!server_mode) {
         const auto& encounter_path = parser.get<std::string>("--encounter");
@@ -71,11 +76,11 @@ int main(int argc, char** argv) {
         int port = std::stoi(
             server_configuration.substr(delimiter_index + 1, server_configuration.size()));
         const auto cache_size_MiB = parser.get<int>("--cache-size");
-        const auto average_registry_size_in_MiB = parser.get<int>("--average-registry-size");
         auto& registry_cache = gw2combat::mru_cache_t<registry_t>::instance();
-        registry_cache.resize(cache_size_MiB, average_registry_size_in_MiB);
+        registry_cache.resize(cache_size_MiB);
         start_server_tcp(hostname, port);
     }
+    spdlog::shutdown();
     return 0;
 }
 
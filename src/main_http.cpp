@@ -10,6 +10,7 @@
 
 #include "spdlog/spdlog.h"
 #include "utils/io_utils.hpp"
+#include "utils/log_utils.hpp"
 
 #include "argparse/argparse.hpp"
 
@@ -33,14 +34,24 @@ int main(int argc, char** argv) {
         .default_value(4096)
         .scan<'i', int>()
         .help("Cache size in MiB.");
-    parser.add_argument("--average-registry-size")
-        .default_value(64)
-        .scan<'i', int>()
-        .help("Average registry size in MiB.");
     parser.add_argument("--threads")
         .scan<'i', int>()
         .default_value(1)
-        .help("Number of threads to use.");
+        .help("Number of threads handling connections.");
+    parser.add_argument("--simulation-threads")
+        .scan<'i', int>()
+        .default_value(1)
+        .help("Number of threads running simulations.");
+    parser.add_argument("--max-queued-simulations")
+        .scan<'i', int>()
+        .default_value(64)
+        .help(
+            "Number of simulations that may wait for a simulation thread. Requests beyond that "
+            "are rejected with 503 Service Unavailable.");
+    parser.add_argument("--trace")
+        .default_value(false)
+        .implicit_value(true)
+        .help("Log every simulation event. Only available in debug builds.");
 
     try {
         parser.parse_args(argc, argv);
@@ -50,22 +61,30 @@ int main(int argc, char** argv) {
         std::exit(1);
     }
 
+    if (parser.get<bool>("--trace")) {
+        utils::enable_tracing();
+    }
+
     const auto& server_configuration = parser.get<std::string>("--server");
     auto delimiter_index = server_configuration.find(':');
     const std::string& hostname = server_configuration.substr(0, delimiter_index);
     int port =
         std::stoi(server_configuration.substr(delimiter_index + 1, server_configuration.size()));
     const auto cache_size_MiB = parser.get<int>("--cache-size");
-    const auto average_registry_size_in_MiB = parser.get<int>("--average-registry-size");
     const auto threads = parser.get<int>("threads");
+    const auto simulation_threads = parser.get<int>("--simulation-threads");
+    const auto max_queued_simulations = parser.get<int>("--max-queued-simulations");
     auto& registry_cache = gw2combat::mru_cache_t<registry_t>::instance();
-    registry_cache.resize(cache_size_MiB, average_registry_size_in_MiB);
+    registry_cache.resize(cache_size_MiB);
     http_server_config_t config{
         .server_host = hostname,
         .server_port = static_cast<unsigned short>(port),
         .threads = threads,
+        .simulation_threads = simulation_threads,
+        .max_queued_simulations = static_cast<std::size_t>(max_queued_simulations),
     };
     start_server_http(config);
+    spdlog::shutdown();
     return 0;
 }
 
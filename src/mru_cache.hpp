@@ -1,71 +1,162 @@
 #ifndef GW2COMBAT_MRU_CACHE_HPP
 #define GW2COMBAT_MRU_CACHE_HPP
 
-#include <list>
-#include <string>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <unordered_map>
 
+#include "utils/hash_utils.hpp"
+
 namespace gw2combat {
 
-template <typename T>
+// Thread-safe cache that evicts the least recently used entries of a shard once the shard exceeds
+// its share of the byte budget. Keys are spread over shards that are locked independently. Lookups
+// only take a shared lock and record their access in an atomic timestamp, so concurrent readers
+// never wait on each other.
+template <typename T, std::size_t shard_count = 16>
 struct mru_cache_t {
-    using key_type = unsigned long;
+    using key_type = utils::hash128_t;
 
     [[nodiscard]] static mru_cache_t<T>& instance() {
         static mru_cache_t<T> instance(4096);
         return instance;
     }
 
-    [[nodiscard]] static key_type djb2_hash(const std::string& str) {
-        unsigned long hash = 5381;
-        for (auto& c : str) {
-            hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+    [[nodiscard]] bool contains(key_type key) const {
+        auto& shard = get_shard(key);
+        std::shared_lock lock{shard.mutex};
+        return shard.entries.find(key) != shard.entries.end();
+    }
+
+    // Calls fn with the cached value while other threads are prevented from replacing or evicting
+    // it. Returns false without calling fn if the key isn't cached.
+    template <typename Fn>
+    bool visit(key_type key, Fn&& fn) const {
+        auto& shard = get_shard(key);
+        std::shared_lock lock{shard.mutex};
+        auto item = shard.entries.find(key);
+        if (item == shard.entries.end()) {
+            return false;
         }
-        return static_cast<key_type>(hash);
+        item->second.last_access.store(next_access(), std::memory_order_relaxed);
+        fn(static_cast<const T&>(item->second.value));
+        return true;
     }
 
-    [[nodiscard]] bool contains(key_type key) const {
-        return cache.find(key) != cache.end();
-    }
-
-    [[nodiscard]] T& get(key_type key) {
-        auto item = cache.find(key);
-        mru_list.erase(item->second.second);
-        mru_list.push_front(key);
-        item->second.second = mru_list.begin();
-        return item->second.first;
-    }
-
-    T& put(key_type key, T&& value) {
-        auto item = cache.find(key);
-        if (item != cache.end()) {
-            mru_list.erase(item->second.second);
-            cache.erase(item);
-        } else {
-            while (cache.size() >= capacity) {
-                cache.erase(mru_list.back());
-                mru_list.pop_back();
-            }
+    // Stores a value that takes up size_in_bytes of memory. Values larger than a shard's share of
+    // the budget are not cached.
+    void put(key_type key, T&& value, size_t size_in_bytes) {
+        auto& shard = get_shard(key);
+        std::unique_lock lock{shard.mutex};
+        auto item = shard.entries.find(key);
+        if (item != shard.entries.end()) {
+            erase(shard, item);
+        }
+        size_t shard_capacity_in_bytes = get_shard_capacity_in_bytes(key);
+        if (size_in_bytes > shard_capacity_in_bytes) {
+            return;
         }
+        while (shard.size_in_bytes + size_in_bytes > shard_capacity_in_bytes) {
+            erase(shard, get_least_recently_used(shard));
+        }
+        shard.entries.try_emplace(key, std::move(value), size_in_bytes, next_access());
+        shard.size_in_bytes += size_in_bytes;
+        total_size_in_bytes += size_in_bytes;
+    }
 
-        mru_list.push_front(key);
-        cache[key] = {std::move(value), mru_list.begin()};
-        return cache[key].first;
+    [[nodiscard]] std::optional<size_t> get_size_in_bytes(key_type key) const {
+        auto& shard = get_shard(key);
+        std::shared_lock lock{shard.mutex};
+        auto item = shard.entries.find(key);
+        if (item == shard.entries.end()) {
+            return std::nullopt;
+        }
+        return item->second.size_in_bytes;
+    }
+
+    [[nodiscard]] size_t get_size_in_bytes() const {
+        return total_size_in_bytes.load();
+    }
+
+    [[nodiscard]] size_t get_capacity_in_bytes() const {
+        return capacity_in_bytes.load();
     }
 
-    void resize(int desired_size_in_MiB, int average_registry_size_in_MiB = 64.0) {
-        capacity = desired_size_in_MiB / average_registry_size_in_MiB;
+    // Shrinking the budget takes effect as entries are inserted into each shard.
+    void resize(size_t desired_size_in_MiB) {
+        capacity_in_bytes.store(desired_size_in_MiB * 1024 * 1024);
     }
 
    protected:
-    explicit mru_cache_t(int desired_size_in_MiB, int average_registry_size_in_MiB = 64.0)
-        : capacity(desired_size_in_MiB / average_registry_size_in_MiB) {
+    explicit mru_cache_t(size_t desired_size_in_MiB)
+        : capacity_in_bytes(desired_size_in_MiB * 1024 * 1024) {
     }
 
    private:
-    size_t capacity;
-    std::list<key_type> mru_list;
-    std::unordered_map<key_type, std::pair<T, std::list<key_type>::iterator>> cache;
+    struct entry_t {
+        entry_t(T&& value, size_t size_in_bytes, std::uint64_t last_access)
+            : value(std::move(value)), size_in_bytes(size_in_bytes), last_access(last_access) {
+        }
+
+        T value;
+        size_t size_in_bytes;
+        mutable std::atomic<std::uint64_t> last_access;
+    };
+
+    struct shard_t {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<key_type, entry_t> entries;
+        size_t size_in_bytes = 0;
+    };
+
+    void erase(shard_t& shard, typename std::unordered_map<key_type, entry_t>::iterator item) {
+        shard.size_in_bytes -= item->second.size_in_bytes;
+        total_size_in_bytes -= item->second.size_in_bytes;
+        shard.entries.erase(item);
+    }
+
+    [[nodiscard]] static size_t get_shard_index(key_type key) {
+        return key.low % shard_count;
+    }
+
+    [[nodiscard]] shard_t& get_shard(key_type key) {
+        return shards[get_shard_index(key)];
+    }
+
+    [[nodiscard]] const shard_t& get_shard(key_type key) const {
+        return shards[get_shard_index(key)];
+    }
+
+    // Splits the budget evenly between shards, handing out the remainder to the first shards.
+    [[nodiscard]] size_t get_shard_capacity_in_bytes(key_type key) const {
+        size_t current_capacity_in_bytes = capacity_in_bytes.load();
+        return current_capacity_in_bytes / shard_count +
+               (get_shard_index(key) < current_capacity_in_bytes % shard_count ? 1 : 0);
+    }
+
+    [[nodiscard]] std::uint64_t next_access() const {
+        return access_clock.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static auto get_least_recently_used(shard_t& shard) {
+        auto least_recently_used = shard.entries.begin();
+        for (auto item = shard.entries.begin(); item != shard.entries.end(); ++item) {
+            if (item->second.last_access.load(std::memory_order_relaxed) <
+                least_recently_used->second.last_access.load(std::memory_order_relaxed)) {
+                least_recently_used = item;
+            }
+        }
+        return least_recently_used;
+    }
+
+    std::atomic<size_t> capacity_in_bytes;
+    std::atomic<size_t> total_size_in_bytes = 0;
+    mutable std::atomic<std::uint64_t> access_clock = 0;
+    std::array<shard_t, shard_count> shards;
 };
 
 }  // namespace gw2combat
@@ -1,5 +1,8 @@
 #include "server_http.hpp"
 
+#include <atomic>
+#include <optional>
+
 #include "boost/asio.hpp"
 #include "boost/url.hpp"
 
@@ -8,6 +11,7 @@
 #include "nlohmann/json.hpp"
 
 #include "configuration/encounter.hpp"
+#include "configuration/encounter_batch.hpp"
 
 #include "combat_loop.hpp"
 
@@ -75,25 +79,46 @@ auto health(const parsed_request_t& request) -> http::message_generator {
     return response;
 }
 
-auto simulate(const parsed_request_t& request) -> http::message_generator {
+// Returns an error response if the request can't be simulated.
+auto validate_simulation_request(const parsed_request_t& request)
+    -> std::optional<http::message_generator> {
     if (auto headers = request.headers(); !headers.contains("Content-Type") ||
                                           headers["Content-Type"] != MIME_TYPE_APPLICATION_JSON) {
         return bad_request(request.raw_request(), "Content-Type must be application/json");
     }
 
-    const auto& request_body = request.body();
-    if (request_body.empty()) {
+    if (request.body().empty()) {
         return bad_request(request.raw_request(), "Request body must not be empty");
     }
+    return std::nullopt;
+}
 
+// Runs on a simulation thread. A batch fans out over batch_threads threads and responds with the
+// array of its reports.
+auto simulate(const http_request& request, int batch_threads) -> http_response {
     std::string response_body;
     try {
-        const auto encounter =
-            nlohmann::json::parse(request_body).get<configuration::encounter_t>();
-        response_body = combat_loop(encounter, encounter.enable_caching);
+        if (parsed_request_t{request}.path() == "/simulate_batch") {
+            const auto batch =
+                nlohmann::json::parse(request.body()).get<configuration::encounter_batch_t>();
+            auto results = combat_loop_batch(
+                batch.encounter, batch.rotations, batch.encounter.enable_caching, batch_threads);
+            response_body = "[";
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (i > 0) {
+                    response_body += ",";
+                }
+                response_body += results[i];
+            }
+            response_body += "]";
+        } else {
+            const auto encounter =
+                nlohmann::json::parse(request.body()).get<configuration::encounter_t>();
+            response_body = combat_loop(encounter, encounter.enable_caching);
+        }
     } catch (const std::exception& err) {
         spdlog::error("error: {}", err.what());
-        return bad_request(request.raw_request(), err.what());
+        return bad_request(request, err.what());
     }
 
     http_response response{http::status::ok, request.version()};
@@ -104,7 +129,9 @@ auto simulate(const parsed_request_t& request) -> http::message_generator {
     return response;
 }
 
-auto handle_request(const http_request&& request) -> http::message_generator {
+// Returns the response to the request, or nothing if the request is a simulation, which has to be
+// handed to a simulation thread.
+auto handle_request(const http_request& request) -> std::optional<http::message_generator> {
     if (request.method() != http::verb::get) {
         return bad_request(request, "Only GET method is supported");
     }
@@ -133,8 +160,8 @@ auto handle_request(const http_request&& request) -> http::message_generator {
     if (path == "/health") {
         return health(parsed_request);
     }
-    if (path == "/simulate") {
-        return simulate(parsed_request);
+    if (path == "/simulate" || path == "/simulate_batch") {
+        return validate_simulation_request(parsed_request);
     }
 
     http::response<http::empty_body> response{http::status::not_found, request.version()};
@@ -144,9 +171,49 @@ auto handle_request(const http_request&& request) -> http::message_generator {
     return response;
 }
 
+// Runs simulations on a fixed number of threads, separate from the threads handling connections,
+// so that a long simulation doesn't stall other connections. Once max_queued_simulations are
+// waiting for a thread, further simulations are rejected instead of queued.
+class simulation_executor_t {
+   public:
+    simulation_executor_t(int threads, std::size_t max_queued_simulations)
+        : thread_pool_(threads),
+          threads_(threads),
+          max_queued_simulations_(max_queued_simulations) {
+    }
+
+    [[nodiscard]] auto threads() const -> int {
+        return threads_;
+    }
+
+    template <typename Task>
+    [[nodiscard]] auto try_post(Task&& task) -> bool {
+        if (queued_simulations_.fetch_add(1) >= max_queued_simulations_) {
+            queued_simulations_.fetch_sub(1);
+            return false;
+        }
+        boost::asio::post(thread_pool_, [this, task = std::forward<Task>(task)]() mutable {
+            queued_simulations_.fetch_sub(1);
+            task();
+        });
+        return true;
+    }
+
+    auto join() -> void {
+        thread_pool_.join();
+    }
+
+   private:
+    boost::asio::thread_pool thread_pool_;
+    const int threads_;
+    const std::size_t max_queued_simulations_;
+    std::atomic<std::size_t> queued_simulations_ = 0;
+};
+
 class session_t : public std::enable_shared_from_this<session_t> {
    public:
-    explicit session_t(tcp::socket&& socket) : stream_{std::move(socket)} {
+    session_t(tcp::socket&& socket, simulation_executor_t& simulation_executor)
+        : stream_{std::move(socket)}, simulation_executor_(simulation_executor) {
     }
 
     void begin() {
@@ -174,11 +241,30 @@ class session_t : public std::enable_shared_from_this<session_t> {
             spdlog::error("on_read: {}, {}", ec.value(), ec.message());
             return;
         }
-        send_response(handle_request(std::move(req_.get())));
+        if (auto response = handle_request(req_.get())) {
+            return send_response(std::move(*response));
+        }
+        // The request stays in req_ until the response is written, since no further request is
+        // read before that.
+        bool is_queued = simulation_executor_.try_post(
+            [self = shared_from_this()] { self->on_simulation_thread(); });
+        if (!is_queued) {
+            send_response(service_unavailable(req_.get(), "Too many simulations are queued"));
+        }
+    }
+
+    void on_simulation_thread() {
+        auto response = simulate(req_.get(), simulation_executor_.threads());
+        boost::asio::post(stream_.get_executor(),
+                          [self = shared_from_this(), response = std::move(response)]() mutable {
+                              self->send_response(std::move(response));
+                          });
     }
 
     void send_response(http::message_generator&& msg) {
         bool keep_alive = msg.keep_alive();
+        // The read timeout would otherwise also count the time spent waiting for the simulation.
+        stream_.expires_after(std::chrono::seconds(30));
         boost::beast::async_write(
             stream_,
             std::move(msg),
@@ -217,13 +303,17 @@ class session_t : public std::enable_shared_from_this<session_t> {
     boost::beast::tcp_stream stream_;
     boost::beast::flat_buffer buffer_;
     http::request_parser<http::string_body> req_;
+    simulation_executor_t& simulation_executor_;
 };
 
 class connection_listener_t : public std::enable_shared_from_this<connection_listener_t> {
    public:
     connection_listener_t(boost::asio::io_context& io_context,
-                          const boost::asio::ip::tcp::endpoint& endpoint)
-        : io_context_(io_context), acceptor_{boost::asio::make_strand(io_context)} {
+                          const boost::asio::ip::tcp::endpoint& endpoint,
+                          simulation_executor_t& simulation_executor)
+        : io_context_(io_context),
+          acceptor_{boost::asio::make_strand(io_context)},
+          simulation_executor_(simulation_executor) {
         acceptor_.open(endpoint.protocol());
         acceptor_.set_option(boost::asio::socket_base::reuse_address(true));
         acceptor_.bind(endpoint);
@@ -249,23 +339,26 @@ class connection_listener_t : public std::enable_shared_from_this<connection_lis
             spdlog::error("on_connection: {}", ec.message());
             return;
         }
-        std::make_shared<session_t>(std::move(socket))->begin();
+        std::make_shared<session_t>(std::move(socket), simulation_executor_)->begin();
         accept_connections();
     }
 
     boost::asio::io_context& io_context_;
     tcp::acceptor acceptor_;
+    simulation_executor_t& simulation_executor_;
 };
 
 auto start_server_http(const http_server_config_t& config) -> void {
     boost::asio::io_context io_context{config.threads};
+    simulation_executor_t simulation_executor{config.simulation_threads,
+                                              config.max_queued_simulations};
 
     boost::asio::signal_set signals{io_context, SIGINT, SIGTERM};
     signals.async_wait([&](auto, auto) { io_context.stop(); });
 
     const auto endpoint = boost::asio::ip::tcp::endpoint{
         boost::asio::ip::make_address(config.server_host), config.server_port};
-    std::make_shared<connection_listener_t>(io_context, endpoint)->begin();
+    std::make_shared<connection_listener_t>(io_context, endpoint, simulation_executor)->begin();
 
     std::vector<std::thread> threads;
     threads.reserve(config.threads - 1);
@@ -273,6 +366,10 @@ auto start_server_http(const http_server_config_t& config) -> void {
         threads.emplace_back([&io_context] { io_context.run(); });
     }
     io_context.run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    simulation_executor.join();
 }
 
 }  // namespace gw2combat
@@ -43,10 +43,22 @@ inline auto internal_server_error(const http_request& request, const boost::beas
     return response;
 }
 
+inline auto service_unavailable(const http_request& request, const boost::beast::string_view why)
+    -> http_response {
+    http_response response{http::status::service_unavailable, request.version()};
+    response.set(http::field::content_type, MIME_TYPE_TEXT_PLAIN);
+    response.keep_alive(request.keep_alive());
+    response.body() = std::string(why);
+    response.prepare_payload();
+    return response;
+}
+
 struct http_server_config_t {
     std::string server_host = "127.0.0.1";
     unsigned short server_port = 54321;
     int threads = 1;
+    int simulation_threads = 1;
+    std::size_t max_queued_simulations = 64;
 };
 
 extern auto start_server_http(const http_server_config_t& config) -> void;
@@ -1,9 +1,13 @@
 #include "server_tcp.hpp"
 
+#include <thread>
+
 #include "asio/asio.hpp"
 
 #include "combat_loop.hpp"
 
+#include "configuration/encounter_batch.hpp"
+
 namespace gw2combat {
 
 using tcp = asio::ip::tcp;
@@ -24,8 +28,26 @@ asio::awaitable<void> request_handler(tcp::socket socket) {
         std::string payload;
         std::getline(istream, payload);
 
-        auto encounter = nlohmann::json::parse(payload).get<configuration::encounter_t>();
-        auto simulation_result_json = combat_loop(encounter, encounter.enable_caching);
+        // A payload with rotations is a batch, which is answered with the array of its reports.
+        auto payload_json = nlohmann::json::parse(payload);
+        std::string simulation_result_json;
+        if (payload_json.contains("rotations")) {
+            auto batch = payload_json.get<configuration::encounter_batch_t>();
+            int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            auto results = combat_loop_batch(
+                batch.encounter, batch.rotations, batch.encounter.enable_caching, threads);
+            simulation_result_json = "[";
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (i > 0) {
+                    simulation_result_json += ",";
+                }
+                simulation_result_json += results[i];
+            }
+            simulation_result_json += "]";
+        } else {
+            auto encounter = payload_json.get<configuration::encounter_t>();
+            simulation_result_json = combat_loop(encounter, encounter.enable_caching);
+        }
         co_await asio::async_write(
             socket,
             asio::buffer(simulation_result_json, simulation_result_json.size()),
@@ -0,0 +1,61 @@
+#ifndef GW2COMBAT_SINGLE_FLIGHT_HPP
+#define GW2COMBAT_SINGLE_FLIGHT_HPP
+
+#include <exception>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+#include "utils/hash_utils.hpp"
+
+namespace gw2combat {
+
+// Collapses concurrent calls for the same key into one. The first caller runs the call, and callers
+// that arrive while it is still running wait for it and receive a copy of its result, or its
+// exception. Once the call finishes, the next caller for the key runs it again.
+template <typename T>
+struct single_flight_t {
+    using key_type = utils::hash128_t;
+
+    [[nodiscard]] static single_flight_t<T>& instance() {
+        static single_flight_t<T> instance;
+        return instance;
+    }
+
+    template <typename Fn>
+    T run(key_type key, Fn&& fn) {
+        std::unique_lock lock{mutex};
+        if (auto item = in_flight.find(key); item != in_flight.end()) {
+            auto result = item->second;
+            lock.unlock();
+            return result.get();
+        }
+        std::promise<T> promise;
+        in_flight.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        try {
+            T result = fn();
+            finish(key);
+            promise.set_value(result);
+            return result;
+        } catch (...) {
+            finish(key);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+   private:
+    void finish(key_type key) {
+        std::lock_guard lock{mutex};
+        in_flight.erase(key);
+    }
+
+    std::mutex mutex;
+    std::unordered_map<key_type, std::shared_future<T>> in_flight;
+};
+
+}  // namespace gw2combat
+
+#endif  // GW2COMBAT_SINGLE_FLIGHT_HPP
@@ -0,0 +1,50 @@
+#ifndef GW2COMBAT_SKILL_CONFIGURATION_TABLE_HPP
+#define GW2COMBAT_SKILL_CONFIGURATION_TABLE_HPP
+
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+
+#include "symbol_table.hpp"
+
+#include "configuration/skill.hpp"
+
+namespace gw2combat {
+
+using skill_handle_t = std::uint32_t;
+
+// Holds the configuration of every skill of an encounter once, indexed by handle, so that skill
+// entities only store the handle. Skills are only added while the encounter is set up, after which
+// the table never changes, so every copy of the registry shares it through its context.
+struct skill_configuration_table_t {
+    static constexpr skill_handle_t invalid_handle = std::numeric_limits<skill_handle_t>::max();
+
+    // Returns the handle of an equal configuration of the skill, adding the configuration if the
+    // table doesn't have one yet.
+    skill_handle_t intern(symbol_t skill_id, const configuration::skill_t& skill) {
+        auto& handles = handles_by_skill_id[skill_id];
+        for (auto handle : handles) {
+            if (skills[handle] == skill) {
+                return handle;
+            }
+        }
+        auto handle = static_cast<skill_handle_t>(skills.size());
+        skills.emplace_back(skill);
+        handles.emplace_back(handle);
+        return handle;
+    }
+
+    [[nodiscard]] const configuration::skill_t& get(skill_handle_t handle) const {
+        return skills.at(handle);
+    }
+
+    std::deque<configuration::skill_t> skills;
+    std::unordered_map<symbol_t, std::vector<skill_handle_t>> handles_by_skill_id;
+};
+
+}  // namespace gw2combat
+
+#endif  // GW2COMBAT_SKILL_CONFIGURATION_TABLE_HPP
@@ -0,0 +1,64 @@
+#ifndef GW2COMBAT_SYMBOL_TABLE_HPP
+#define GW2COMBAT_SYMBOL_TABLE_HPP
+
+#include <deque>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+
+#include "common.hpp"
+
+namespace gw2combat {
+
+using symbol_t = std::uint32_t;
+
+// Maps the keys that configurations refer to skills, counters and unique effects by to dense
+// integer ids, so that runtime lookups compare integers instead of strings. Every registry owns a
+// table in its context, which only ever grows, so ids stay valid in copies of the registry. The
+// empty key has no id, and invalid_symbol maps back to the empty key.
+struct symbol_table_t {
+    static constexpr symbol_t invalid_symbol = std::numeric_limits<symbol_t>::max();
+
+    struct key_hash_t {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t operator()(std::string_view key) const {
+            return std::hash<std::string_view>{}(key);
+        }
+    };
+
+    // Returns the id of the key, assigning the next id to keys that don't have one yet.
+    symbol_t intern(std::string_view key) {
+        if (key.empty()) {
+            return invalid_symbol;
+        }
+        if (auto item = symbols.find(key); item != symbols.end()) {
+            return item->second;
+        }
+        auto symbol = static_cast<symbol_t>(keys.size());
+        keys.emplace_back(key);
+        symbols.emplace(keys.back(), symbol);
+        return symbol;
+    }
+
+    // Returns invalid_symbol for keys that don't have an id, which nothing in the registry can be
+    // looked up by.
+    [[nodiscard]] symbol_t find(std::string_view key) const {
+        if (auto item = symbols.find(key); item != symbols.end()) {
+            return item->second;
+        }
+        return invalid_symbol;
+    }
+
+    [[nodiscard]] const std::string& get_key(symbol_t symbol) const {
+        static const std::string empty_key;
+        return symbol == invalid_symbol ? empty_key : keys.at(symbol);
+    }
+
+    std::deque<std::string> keys;
+    std::unordered_map<std::string, symbol_t, key_hash_t, std::equal_to<>> symbols;
+};
+
+}  // namespace gw2combat
+
+#endif  // GW2COMBAT_SYMBOL_TABLE_HPP
@@ -16,6 +16,7 @@
 #include "utils/condition_utils.hpp"
 #include "utils/effect_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
 #include "utils/side_effect_utils.hpp"
 #include "utils/weapon_utils.hpp"
 
@@ -35,7 +36,7 @@ damage_result_t calculate_damage(
     const component::relative_attributes& target_relative_attributes,
     registry_t& registry) {
     auto& encounter =
-        registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
+        *registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
             .encounter;
     double skill_intrinsic_damage = weapon_strength * skill_configuration.damage_coefficient;
 
@@ -104,8 +105,10 @@ void apply_strikes(registry_t& registry) {
                 entity_t strike_source_entity = utils::get_owner(strike.source_entity, registry);
                 auto& strike_source_relative_attributes =
                     registry.get<component::relative_attributes>(strike_source_entity);
-                auto& is_skill = registry.get<component::is_skill>(strike.strike.skill_entity);
-                auto& skill_configuration = is_skill.skill_configuration;
+                auto skill_handle =
+                    registry.get<component::is_skill>(strike.strike.skill_entity).skill_handle;
+                auto& skill_configuration =
+                    utils::get_skill_configuration_table(registry).get(skill_handle);
 
                 auto damage = calculate_damage(skill_configuration,
                                                strike.strike.weapon_strength_roll,
@@ -116,23 +119,17 @@ void apply_strikes(registry_t& registry) {
                                                registry);
 
                 auto& incoming_damage =
-                    registry.get_or_emplace<component::incoming_damage>(target_entity);
+                    utils::get_or_emplace_frame_component<component::incoming_damage>(
+                        target_entity, registry);
                 incoming_damage.incoming_damage_events.emplace_back(
-                    component::incoming_damage_event{utils::get_current_tick(registry),
-                                                     strike_source_entity,
-                                                     actor::effect_t::INVALID,
-                                                     skill_configuration.skill_key,
-                                                     damage.value});
+                    component::incoming_damage_event{
+                        utils::get_current_tick(registry),
+                        strike_source_entity,
+                        actor::effect_t::INVALID,
+                        utils::get_symbol(skill_configuration.skill_key, registry),
+                        damage.value});
 
-                double total_incoming_damage = std::accumulate(
-                    incoming_damage.incoming_damage_events.begin(),
-                    incoming_damage.incoming_damage_events.end(),
-                    0.0,
-                    [](double accumulated,
-                       const component::incoming_damage_event& incoming_damage_event) {
-                        return accumulated + incoming_damage_event.value;
-                    });
-                spdlog::info(
+                GW2COMBAT_TRACE(
                     "[{}] skill {} pow {} fero {} prec {} crit% {} crit_mult {} is_crit {} "
                     "ws_roll {} this_dmg {} total_incoming_dmg {}",
                     utils::get_current_tick(registry),
@@ -149,7 +146,13 @@ void apply_strikes(registry_t& registry) {
                     damage.is_critical,
                     strike.strike.weapon_strength_roll,
                     damage.value,
-                    total_incoming_damage);
+                    std::accumulate(incoming_damage.incoming_damage_events.begin(),
+                                    incoming_damage.incoming_damage_events.end(),
+                                    0.0,
+                                    [](double accumulated,
+                                       const component::incoming_damage_event& event) {
+                                        return accumulated + event.value;
+                                    }));
 
                 // NOTE: Extreme hack to avoid coding a whole new type of damage just for food.
                 //       Implement properly if there are more such instances!
@@ -165,27 +168,33 @@ void apply_strikes(registry_t& registry) {
                                                                  skill_configuration,
                                                                  registry);
                 };
-                utils::apply_side_effects(registry, strike_source_entity, side_effect_condition_fn);
+                utils::apply_side_effects(registry,
+                                          strike_source_entity,
+                                          damage.is_critical
+                                              ? component::side_effect_trigger_t::ON_CRITICAL_STRIKE
+                                              : component::side_effect_trigger_t::ON_STRIKE,
+                                          side_effect_condition_fn);
 
                 auto& outgoing_effects_component =
-                    registry.get_or_emplace<component::outgoing_effects_component>(
-                        strike_source_entity);
-                std::transform(
-                    skill_configuration.on_strike_effect_applications.begin(),
-                    skill_configuration.on_strike_effect_applications.end(),
-                    std::back_inserter(outgoing_effects_component.effect_applications),
-                    [&](const configuration::effect_application_t& effect_application) {
-                        return component::effect_application_t{
-                            .condition = effect_application.condition,
-                            .source_skill = skill_configuration.skill_key,
+                    utils::get_or_emplace_frame_component<component::outgoing_effects_component>(
+                        strike_source_entity, registry);
+                auto& effect_applications = skill_configuration.on_strike_effect_applications;
+                for (std::size_t application_idx = 0; application_idx < effect_applications.size();
+                     ++application_idx) {
+                    auto& effect_application = effect_applications[application_idx];
+                    outgoing_effects_component.effect_applications.emplace_back(
+                        component::effect_application_t{
+                            .skill_handle = skill_handle,
+                            .skill_action =
+                                component::effect_application_t::skill_action_t::STRIKE,
+                            .application_idx = static_cast<std::uint32_t>(application_idx),
                             .effect = effect_application.effect,
-                            .unique_effect = effect_application.unique_effect,
                             .direction = component::effect_application_t::convert_direction(
                                 effect_application.direction),
                             .base_duration_ms = effect_application.base_duration_ms,
                             .num_stacks = effect_application.num_stacks,
-                            .num_targets = effect_application.num_targets};
-                    });
+                            .num_targets = effect_application.num_targets});
+                }
             }
         });
 }
@@ -197,19 +206,23 @@ void apply_effects(registry_t& registry) {
             for (const auto& incoming_application :
                  incoming_effects_component.effect_applications) {
                 const auto& application = incoming_application.effect_application;
+                auto& application_configuration =
+                    utils::get_effect_application_configuration(application, registry);
+                auto& source_skill =
+                    utils::get_effect_application_source_skill(application, registry);
                 entity_t application_source_entity =
                     utils::get_owner(incoming_application.source_entity, registry);
                 auto& application_source_relative_attributes =
                     registry.get<component::relative_attributes>(application_source_entity);
-                if (!application.unique_effect.is_invalid()) {
-                    utils::add_unique_effect_to_actor(application.unique_effect,
+                if (!application_configuration.unique_effect.is_invalid()) {
+                    utils::add_unique_effect_to_actor(application_configuration.unique_effect,
                                                       application.num_stacks,
                                                       application.base_duration_ms,
-                                                      application.source_skill,
+                                                      source_skill,
                                                       application_source_entity,
                                                       target_entity,
                                                       registry);
-                    spdlog::info(
+                    GW2COMBAT_TRACE(
                         "[{}] {}:{} applied {} stacks of {} duration {} unique effect on {} with "
                         "skill {}",
                         utils::get_current_tick(registry),
@@ -217,9 +230,9 @@ void apply_effects(registry_t& registry) {
                         utils::get_entity_name(incoming_application.source_entity, registry),
                         application.num_stacks,
                         application.base_duration_ms,
-                        application.unique_effect.unique_effect_key,
+                        application_configuration.unique_effect.unique_effect_key,
                         utils::get_entity_name(target_entity, registry),
-                        incoming_application.effect_application.source_skill);
+                        source_skill);
                 }
                 if (application.effect != actor::effect_t::INVALID) {
                     int effective_duration =
@@ -230,11 +243,11 @@ void apply_effects(registry_t& registry) {
                     utils::add_effect_to_actor(application.effect,
                                                application.num_stacks,
                                                effective_duration,
-                                               application.source_skill,
+                                               source_skill,
                                                application_source_entity,
                                                target_entity,
                                                registry);
-                    spdlog::info(
+                    GW2COMBAT_TRACE(
                         "[{}] {}:{} applied {} stacks of {} duration {} effect on {} with skill {}",
                         utils::get_current_tick(registry),
                         utils::get_entity_name(application_source_entity, registry),
@@ -243,7 +256,7 @@ void apply_effects(registry_t& registry) {
                         effective_duration,
                         utils::to_string(application.effect),
                         utils::get_entity_name(target_entity, registry),
-                        incoming_application.effect_application.source_skill);
+                        source_skill);
 
                     auto side_effect_condition_fn =
                         [&](const configuration::condition_t& condition) {
@@ -255,7 +268,10 @@ void apply_effects(registry_t& registry) {
                                 registry);
                         };
                     utils::apply_side_effects(
-                        registry, application_source_entity, side_effect_condition_fn);
+                        registry,
+                        application_source_entity,
+                        component::side_effect_trigger_t::ON_EFFECT_APPLICATION,
+                        side_effect_condition_fn);
                 }
             }
         });
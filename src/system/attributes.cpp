@@ -3,18 +3,142 @@
 #include "utils/condition_utils.hpp"
 #include "utils/effect_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
 
 #include "component/actor/is_actor.hpp"
 #include "component/actor/relative_attributes.hpp"
 #include "component/actor/static_attributes.hpp"
 #include "component/attributes/is_attribute_conversion.hpp"
 #include "component/attributes/is_attribute_modifier.hpp"
+#include "component/counter/is_counter.hpp"
 #include "component/effect/is_effect.hpp"
 #include "component/effect/is_unique_effect.hpp"
+#include "component/effect/source_actor.hpp"
+#include "component/equipment/bundle.hpp"
+#include "component/equipment/weapons.hpp"
 #include "component/hierarchy/owner_component.hpp"
+#include "component/skill/is_conditional_skill_group.hpp"
+#include "component/temporal/cooldown_component.hpp"
 
 namespace gw2combat::system {
 
+struct attribute_inputs_t {
+    std::vector<std::uint64_t> signature;
+    bool is_volatile = false;
+};
+
+[[nodiscard]] bool depends_on_skill_cooldown(const configuration::condition_t& condition) {
+    auto any_depends_on_skill_cooldown =
+        [](const std::vector<configuration::condition_t>& conditions) {
+            return std::any_of(conditions.begin(), conditions.end(), depends_on_skill_cooldown);
+        };
+    return condition.depends_on_skill_off_cooldown.has_value() ||
+           any_depends_on_skill_cooldown(condition.not_conditions) ||
+           any_depends_on_skill_cooldown(condition.or_conditions) ||
+           any_depends_on_skill_cooldown(condition.and_conditions);
+}
+
+// Collects everything that attribute modifier and conversion conditions can observe, grouped by the
+// actor it belongs to. Entries are recorded in view order since the order in which modifiers are
+// applied affects the result. Actors whose modifiers roll random numbers, look at health or resolve
+// conditional skill groups are volatile and have to be recalculated every time.
+std::map<entity_t, attribute_inputs_t> get_attribute_inputs_by_actor(registry_t& registry) {
+    enum class input_t : std::uint64_t
+    {
+        ATTRIBUTE_MODIFIER,
+        ATTRIBUTE_CONVERSION,
+        EFFECT,
+        UNIQUE_EFFECT,
+        COOLDOWN,
+        BUNDLE,
+        WEAPON_SET,
+        COUNTER,
+    };
+    std::map<entity_t, attribute_inputs_t> attribute_inputs_by_actor;
+    auto add_inputs = [&](entity_t actor_entity, std::initializer_list<std::uint64_t> values) {
+        auto& signature = attribute_inputs_by_actor[actor_entity].signature;
+        signature.insert(signature.end(), values);
+    };
+    bool has_conditional_skill_groups =
+        !registry.view<component::is_conditional_skill_group>().empty();
+    auto is_volatile_condition = [&](const configuration::condition_t& condition) {
+        return utils::has_unpredictable_threshold(condition) ||
+               (has_conditional_skill_groups && depends_on_skill_cooldown(condition));
+    };
+
+    registry.view<component::owner_component, component::is_attribute_modifier>().each(
+        [&](entity_t entity,
+            const component::owner_component& owner_component,
+            const component::is_attribute_modifier& is_attribute_modifier) {
+            auto owner_actor = utils::get_owner(owner_component.entity, registry);
+            add_inputs(owner_actor, {std::uint64_t(input_t::ATTRIBUTE_MODIFIER), entity});
+            for (auto& attribute_modifier : is_attribute_modifier.attribute_modifiers) {
+                attribute_inputs_by_actor[owner_actor].is_volatile |=
+                    is_volatile_condition(attribute_modifier.condition);
+            }
+        });
+    registry.view<component::owner_component, component::is_attribute_conversion>().each(
+        [&](entity_t entity,
+            const component::owner_component& owner_component,
+            const component::is_attribute_conversion& is_attribute_conversion) {
+            auto owner_actor = utils::get_owner(owner_component.entity, registry);
+            add_inputs(owner_actor, {std::uint64_t(input_t::ATTRIBUTE_CONVERSION), entity});
+            for (auto& attribute_conversion : is_attribute_conversion.attribute_conversions) {
+                attribute_inputs_by_actor[owner_actor].is_volatile |=
+                    is_volatile_condition(attribute_conversion.condition);
+            }
+        });
+    registry.view<component::is_effect, component::owner_component>().each(
+        [&](entity_t entity,
+            const component::is_effect& is_effect,
+            const component::owner_component& owner_component) {
+            add_inputs(owner_component.entity,
+                       {std::uint64_t(input_t::EFFECT), entity, std::uint64_t(is_effect.effect)});
+        });
+    registry.view<component::is_unique_effect, component::owner_component>().each(
+        [&](entity_t entity,
+            const component::is_unique_effect&,
+            const component::owner_component& owner_component) {
+            auto source_actor_ptr = registry.try_get<component::source_actor>(entity);
+            add_inputs(owner_component.entity,
+                       {std::uint64_t(input_t::UNIQUE_EFFECT),
+                        entity,
+                        source_actor_ptr ? source_actor_ptr->entity : entt::null});
+        });
+    registry.view<component::cooldown_component, component::owner_component>().each(
+        [&](entity_t entity,
+            const component::cooldown_component&,
+            const component::owner_component& owner_component) {
+            add_inputs(owner_component.entity, {std::uint64_t(input_t::COOLDOWN), entity});
+        });
+    registry.view<component::bundle_component>().each(
+        [&](entity_t entity, const component::bundle_component& bundle_component) {
+            add_inputs(entity, {std::uint64_t(input_t::BUNDLE), bundle_component.name.size()});
+            auto& signature = attribute_inputs_by_actor[entity].signature;
+            signature.insert(
+                signature.end(), bundle_component.name.begin(), bundle_component.name.end());
+        });
+    registry.view<component::current_weapon_set>().each(
+        [&](entity_t entity, const component::current_weapon_set& current_weapon_set) {
+            add_inputs(entity,
+                       {std::uint64_t(input_t::WEAPON_SET), std::uint64_t(current_weapon_set.set)});
+        });
+
+    // Counters are global, so they are part of every actor's inputs.
+    std::vector<std::uint64_t> counter_values;
+    registry.view<component::is_counter>().each(
+        [&](entity_t entity, const component::is_counter& is_counter) {
+            counter_values.insert(
+                counter_values.end(),
+                {std::uint64_t(input_t::COUNTER), entity, std::uint64_t(is_counter.value)});
+        });
+    for (auto actor_entity : registry.view<component::relative_attributes>()) {
+        auto& signature = attribute_inputs_by_actor[actor_entity].signature;
+        signature.insert(signature.end(), counter_values.begin(), counter_values.end());
+    }
+    return attribute_inputs_by_actor;
+}
+
 void calculate_relative_attributes(registry_t& registry) {
     if (!registry.view<component::relative_attributes>().empty()) {
         return;
@@ -22,14 +146,46 @@ void calculate_relative_attributes(registry_t& registry) {
     registry
         .view<component::is_actor, component::static_attributes>(
             entt::exclude<component::owner_component, component::relative_attributes>)
-        .each([&](entity_t entity, const component::static_attributes& static_attributes) {
-            auto& relative_attributes = registry.emplace<component::relative_attributes>(entity);
+        .each([&](entity_t entity, const component::static_attributes&) {
+            utils::get_or_emplace_frame_component<component::relative_attributes>(entity, registry);
+        });
+
+    auto attribute_inputs_by_actor = get_attribute_inputs_by_actor(registry);
+    std::map<entity_t, bool> inputs_changed_by_actor;
+    for (auto&& [actor_entity, attribute_inputs] : attribute_inputs_by_actor) {
+        auto cache_ptr = registry.try_get<component::relative_attributes_cache>(actor_entity);
+        inputs_changed_by_actor[actor_entity] =
+            !cache_ptr || cache_ptr->inputs_signature != attribute_inputs.signature;
+    }
+    // A row depends on the owner's modifiers and on both actors' effects.
+    auto is_dirty = [&](entity_t actor_entity, entity_t other_actor) {
+        if (attribute_inputs_by_actor[actor_entity].is_volatile ||
+            inputs_changed_by_actor[actor_entity] || inputs_changed_by_actor[other_actor]) {
+            return true;
+        }
+        auto& cache = registry.get<component::relative_attributes_cache>(actor_entity);
+        return !cache.attributes.contains(other_actor);
+    };
+
+    registry
+        .view<component::static_attributes, component::relative_attributes>(
+            entt::exclude<component::owner_component>)
+        .each([&](entity_t entity,
+                  const component::static_attributes& static_attributes,
+                  component::relative_attributes& relative_attributes) {
             registry
-                .view<component::is_actor, component::static_attributes>(
+                .view<component::static_attributes, component::relative_attributes>(
                     entt::exclude<component::owner_component>)
-                .each([&](entity_t other_actor, const component::static_attributes&) {
-                    for (auto& [attribute, value] : static_attributes.attribute_value_map) {
-                        relative_attributes.set(other_actor, attribute, value);
+                .each([&](entity_t other_actor,
+                          const component::static_attributes&,
+                          const component::relative_attributes&) {
+                    if (is_dirty(entity, other_actor)) {
+                        relative_attributes.get_or_emplace(other_actor) =
+                            static_attributes.attribute_value_map;
+                    } else {
+                        relative_attributes.get_or_emplace(other_actor) =
+                            registry.get<component::relative_attributes_cache>(entity)
+                                .attributes.get(other_actor);
                     }
                 });
         });
@@ -50,6 +206,9 @@ void calculate_relative_attributes(registry_t& registry) {
             registry.view<component::relative_attributes>().each([&](entity_t other_actor,
                                                                      const component::
                                                                          relative_attributes&) {
+                if (!is_dirty(owner_actor, other_actor)) {
+                    return;
+                }
                 if (unique_effect_modifier_ptr) {
                     if (modifier_unique_effect_and_owner_actor_and_other_actor_to_occurrences_map
                             [std::make_tuple(
@@ -80,9 +239,8 @@ void calculate_relative_attributes(registry_t& registry) {
                     }
                 }
                 for (auto& attribute_modifier : is_attribute_modifier.attribute_modifiers) {
-                    if (utils::independent_conditions_satisfied(
-                            attribute_modifier.condition, owner_actor, other_actor, registry)
-                            .satisfied) {
+                    if (utils::are_independent_conditions_satisfied(
+                            attribute_modifier.condition, owner_actor, other_actor, registry)) {
                         relative_attributes.set(
                             other_actor,
                             attribute_modifier.attribute,
@@ -118,6 +276,9 @@ void calculate_relative_attributes(registry_t& registry) {
                 auto effect_conversion_ptr =
                     registry.try_get<component::is_effect>(owner_component.entity);
                 auto owner_actor = utils::get_owner(owner_component.entity, registry);
+                if (!is_dirty(owner_actor, other_actor)) {
+                    return;
+                }
                 auto& relative_attributes =
                     registry.get<component::relative_attributes>(owner_actor);
                 if (unique_effect_conversion_ptr) {
@@ -150,9 +311,8 @@ void calculate_relative_attributes(registry_t& registry) {
                     }
                 }
                 for (auto& attribute_conversion : is_attribute_conversion.attribute_conversions) {
-                    if (utils::independent_conditions_satisfied(
-                            attribute_conversion.condition, owner_actor, other_actor, registry)
-                            .satisfied) {
+                    if (utils::are_independent_conditions_satisfied(
+                            attribute_conversion.condition, owner_actor, other_actor, registry)) {
                         owner_actor_to_attribute_conversion_bonuses[std::make_tuple(
                             owner_actor, attribute_conversion.to)] +=
                             (relative_attributes.get(other_actor, attribute_conversion.from) *
@@ -180,9 +340,12 @@ void calculate_relative_attributes(registry_t& registry) {
     });
 
     registry.view<component::relative_attributes>().each(
-        [&](entity_t, component::relative_attributes& relative_attributes) {
+        [&](entity_t actor_entity, component::relative_attributes& relative_attributes) {
             registry.view<component::relative_attributes>().each(
                 [&](entity_t other_actor, const component::relative_attributes&) {
+                    if (!is_dirty(actor_entity, other_actor)) {
+                        return;
+                    }
                     double precision =
                         relative_attributes.get(other_actor, actor::attribute_t::PRECISION);
                     relative_attributes.set(
@@ -241,6 +404,15 @@ void calculate_relative_attributes(registry_t& registry) {
                             utils::round_to_nearest_n_digits(expertise / 1500.0, 2));
                 });
         });
+
+    registry.view<component::relative_attributes>().each(
+        [&](entity_t actor_entity, const component::relative_attributes& relative_attributes) {
+            registry.emplace_or_replace<component::relative_attributes_cache>(
+                actor_entity,
+                component::relative_attributes_cache{
+                    relative_attributes,
+                    std::move(attribute_inputs_by_actor[actor_entity].signature)});
+        });
 }
 
 }  // namespace gw2combat::system
@@ -2,9 +2,12 @@
 
 #include <component/temporal/has_quickness.hpp>
 
+#include "utils/actor_utils.hpp"
 #include "utils/effect_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
 #include "utils/skill_utils.hpp"
+#include "utils/temporal_utils.hpp"
 
 #include "system/attributes.hpp"
 
@@ -20,7 +23,6 @@
 #include "component/effect/is_effect.hpp"
 #include "component/effect/is_unique_effect.hpp"
 #include "component/effect/source_actor.hpp"
-#include "component/effect/source_skill.hpp"
 #include "component/encounter/encounter_configuration_component.hpp"
 #include "component/equipment/bundle.hpp"
 #include "component/equipment/weapons.hpp"
@@ -78,8 +80,8 @@ void audit_effect_expiration(registry_t& registry) {
     auto& audit_component = registry.get<component::audit_component>(utils::get_singleton_entity());
     registry.view<component::duration_expired>().each([&](entity_t entity) {
         auto actor_entity = utils::get_owner(entity, registry);
-        auto source_actor = registry.get<component::source_actor>(entity);
-        auto source_skill = registry.get<component::source_skill>(entity);
+        auto source_actor = utils::get_effect_source_actor(entity, registry);
+        auto source_skill = utils::get_effect_source_skill(entity, registry);
         auto effect = registry.any_of<component::is_effect>(entity)
                           ? nlohmann::json{registry.get<component::is_effect>(entity).effect}[0]
                                 .get<std::string>()
@@ -90,8 +92,8 @@ void audit_effect_expiration(registry_t& registry) {
                 : "";
         audit_component.events.emplace_back(create_tick_event(
             audit::effect_expired_event_t{
-                .source_actor = utils::get_entity_name(source_actor.entity, registry),
-                .source_skill = source_skill.skill,
+                .source_actor = utils::get_entity_name(source_actor, registry),
+                .source_skill = utils::get_symbol_key(source_skill, registry),
                 .effect = effect,
                 .unique_effect = unique_effect,
             },
@@ -142,12 +144,16 @@ void audit_effect_applications(registry_t& registry) {
                                                    effect_application.effect,
                                                    application_source_relative_attributes,
                                                    actor_entity);
+                auto& effect_application_configuration =
+                    utils::get_effect_application_configuration(effect_application, registry);
                 audit_component.events.emplace_back(create_tick_event(
                     audit::effect_application_event_t{
                         .source_actor = source_actor,
-                        .source_skill = effect_application.source_skill,
+                        .source_skill =
+                            utils::get_effect_application_source_skill(effect_application, registry),
                         .effect = effect,
-                        .unique_effect = effect_application.unique_effect.unique_effect_key,
+                        .unique_effect =
+                            effect_application_configuration.unique_effect.unique_effect_key,
                         .num_stacks = effect_application.num_stacks,
                         .duration_ms = effective_duration,
                     },
@@ -167,8 +173,7 @@ void audit_skill_casts(registry_t& registry) {
                     continue;
                 }
                 auto& skill_configuration =
-                    registry.get<component::is_skill>(casting_skill.skill_entity)
-                        .skill_configuration;
+                    utils::get_skill_configuration(casting_skill.skill_entity, registry);
                 int cast_duration = registry.any_of<component::has_quickness>(actor_entity)
                                         ? skill_configuration.cast_duration[1]
                                         : skill_configuration.cast_duration[0];
@@ -188,8 +193,9 @@ void audit_skill_casts(registry_t& registry) {
             for (auto finished_casting_skill_entity : finished_casting_skills.skill_entities) {
                 audit_component.events.emplace_back(create_tick_event(
                     audit::skill_cast_end_event_t{
-                        .skill = registry.get<component::is_skill>(finished_casting_skill_entity)
-                                     .skill_configuration.skill_key,
+                        .skill = utils::get_skill_configuration(finished_casting_skill_entity,
+                                                                registry)
+                                     .skill_key,
                     },
                     actor_entity,
                     registry));
@@ -220,14 +226,14 @@ void audit_damage(registry_t& registry) {
                             default:
                                 throw std::runtime_error("Unknown source for damage!");
                         }
-                    } else if (!incoming_damage_event.skill.empty()) {
+                    } else if (incoming_damage_event.skill != symbol_table_t::invalid_symbol) {
                         return audit::damage_event_t::damage_type_t::STRIKE;
                     } else {
                         throw std::runtime_error("Unknown source for damage!");
                     }
                 }();
                 auto skill_to_attribute_damage_to = [&]() {
-                    if (incoming_damage_event.skill.empty()) {
+                    if (incoming_damage_event.skill == symbol_table_t::invalid_symbol) {
                         return std::string{"unknown_skill"};
                     } else {
                         auto& skill_configuration =
@@ -260,6 +266,17 @@ void audit_afk(registry_t& registry) {
     });
 }
 
+void audit_idle_ticks(registry_t& registry, int num_ticks) {
+    auto& audit_component = registry.get<component::audit_component>(utils::get_singleton_entity());
+    registry
+        .view<component::is_actor>(
+            entt::exclude<component::owner_component, component::animation_component>)
+        .each([&](entity_t actor_entity) {
+            audit_component.afk_ticks_by_actor[utils::get_entity_name(actor_entity, registry)] +=
+                num_ticks;
+        });
+}
+
 void audit(registry_t& registry) {
     auto& audit_configuration =
         registry.get<component::audit_component>(utils::get_singleton_entity()).audit_configuration;
@@ -322,8 +339,9 @@ std::map<std::string, std::vector<std::string>> get_castable_skills_by_actor(reg
             }
 
             auto skill_castability = utils::can_cast_skill(skill_entity, registry);
-            if (skill_castability.can_cast && is_skill.skill_configuration.executable) {
-                actor_castable_skills.emplace_back(is_skill.skill_configuration.skill_key);
+            auto& skill_configuration = utils::get_skill_configuration(is_skill, registry);
+            if (skill_castability.can_cast && skill_configuration.executable) {
+                actor_castable_skills.emplace_back(skill_configuration.skill_key);
             }
         }
         castable_skills_by_actor[utils::get_entity_name(actor_entity, registry)] =
@@ -353,10 +371,12 @@ get_uncastable_skills_by_actor(registry_t& registry) {
             auto ammo = registry.try_get<component::ammo>(skill_entity);
             int remaining_cooldown = 0;
             if (cooldown_component) {
+                auto progress =
+                    utils::get_cooldown_progress(skill_entity, *cooldown_component, registry);
                 double no_alacrity_progress_pct =
-                    cooldown_component->progress[0] * 100.0 / cooldown_component->duration[0];
+                    progress[0] * 100.0 / cooldown_component->duration[0];
                 double alacrity_progress_pct =
-                    cooldown_component->progress[1] * 100.0 / cooldown_component->duration[1];
+                    progress[1] * 100.0 / cooldown_component->duration[1];
                 bool has_alacrity =
                     registry.any_of<component::has_alacrity>(owner_component.entity);
                 remaining_cooldown = static_cast<int>(
@@ -364,7 +384,8 @@ get_uncastable_skills_by_actor(registry_t& registry) {
                     (1.0 - (alacrity_progress_pct + no_alacrity_progress_pct) / 100.0));
             }
             int remaining_ammo = ammo ? ammo->current_ammo : 0;
-            actor_uncastable_skills[is_skill.skill_configuration.skill_key] = {
+            auto& skill_key = utils::get_skill_configuration(is_skill, registry).skill_key;
+            actor_uncastable_skills[skill_key] = {
                 .reason = skill_castability.reason,
                 .remaining_cooldown = remaining_cooldown,
                 .remaining_ammo = remaining_ammo,
@@ -433,11 +454,12 @@ get_effects_by_actor(registry_t& registry) {
             }
 
             auto& duration_component = registry.get<component::duration_component>(effect_entity);
-            auto& source_actor = registry.get<component::source_actor>(effect_entity);
+            auto source_actor = utils::get_effect_source_actor(effect_entity, registry);
             actor_effects.emplace_back(audit::actor_effect_t{
                 .effect = is_effect.effect,
-                .source_actor = utils::get_entity_name(source_actor.entity, registry),
-                .remaining_duration = duration_component.duration - duration_component.progress,
+                .source_actor = utils::get_entity_name(source_actor, registry),
+                .remaining_duration = duration_component.duration -
+                                      utils::get_duration_progress(duration_component, registry),
             });
         }
 
@@ -474,7 +496,8 @@ get_unique_effects_by_actor(registry_t& registry) {
             actor_unique_effects.emplace_back(audit::actor_unique_effect_t{
                 .unique_effect = is_unique_effect.unique_effect.unique_effect_key,
                 .source_actor = utils::get_entity_name(source_actor.entity, registry),
-                .remaining_duration = duration_component.duration - duration_component.progress,
+                .remaining_duration = duration_component.duration -
+                                      utils::get_duration_progress(duration_component, registry),
             });
         }
 
@@ -501,30 +524,46 @@ get_unique_effects_by_actor(registry_t& registry) {
     for (auto&& [actor_entity, relative_attributes] :
          registry.view<component::relative_attributes>(entt::exclude<component::owner_component>)
              .each()) {
-        if (relative_attributes.entity_and_attribute_to_value_map.empty()) {
+        if (relative_attributes.entity_and_attribute_values.empty()) {
             continue;
         }
-        std::map<actor::attribute_t, double> entity_and_attribute_to_value_map =
-            relative_attributes.entity_and_attribute_to_value_map.at(actor_entity);
         const std::string& actor_name = utils::get_entity_name(actor_entity, registry);
-        std::transform(
-            entity_and_attribute_to_value_map.cbegin(),
-            entity_and_attribute_to_value_map.cend(),
-            std::inserter(actor_attributes[actor_name], actor_attributes[actor_name].end()),
-            [](const auto& pair) {
-                return std::pair<std::string, double>{nlohmann::json{pair.first}[0], pair.second};
+        auto& attributes = actor_attributes[actor_name];
+        relative_attributes.get(actor_entity)
+            .for_each([&](actor::attribute_t attribute, double value) {
+                attributes.emplace(nlohmann::json{attribute}[0], value);
             });
     }
-    registry.clear<component::relative_attributes>();
+    utils::clear_frame_components<component::relative_attributes>(registry);
     return actor_attributes;
 }
 
+void share_audit_events(registry_t& registry) {
+    auto& audit_component = registry.get<component::audit_component>(utils::get_singleton_entity());
+    if (audit_component.events.empty()) {
+        return;
+    }
+    audit_component.shared_events.emplace_back(
+        std::make_shared<const std::vector<audit::tick_event_t>>(
+            std::move(audit_component.events)));
+    audit_component.events.clear();
+}
+
 audit::report_t get_audit_report(registry_t& registry, int offset, const std::string& error) {
     auto& audit_component = registry.get<component::audit_component>(utils::get_singleton_entity());
     std::vector<audit::tick_event_t> tick_events;
-    std::copy(audit_component.events.cbegin() + offset,
-              audit_component.events.cend(),
-              std::back_inserter(tick_events));
+    size_t num_events_to_skip = offset;
+    auto copy_events = [&](const std::vector<audit::tick_event_t>& events) {
+        size_t num_skipped_events = std::min(num_events_to_skip, events.size());
+        num_events_to_skip -= num_skipped_events;
+        std::copy(events.cbegin() + static_cast<std::ptrdiff_t>(num_skipped_events),
+                  events.cend(),
+                  std::back_inserter(tick_events));
+    };
+    for (auto& shared_events : audit_component.shared_events) {
+        copy_events(*shared_events);
+    }
+    copy_events(audit_component.events);
     std::optional<std::string> error_optional =
         error.empty() ? std::nullopt : std::make_optional(error);
 
@@ -11,6 +11,10 @@ extern audit::tick_event_t create_tick_event(const decltype(audit::tick_event_t:
                                              entity_t actor_entity,
                                              registry_t& registry);
 extern void audit(registry_t& registry);
+// Audits ticks that were skipped because nothing happened in them.
+extern void audit_idle_ticks(registry_t& registry, int num_ticks);
+// Moves the events recorded so far into a block that copies of the registry share.
+extern void share_audit_events(registry_t& registry);
 extern audit::report_t get_audit_report(registry_t& registry,
                                         int offset = 0,
                                         const std::string& error = {});
@@ -5,11 +5,12 @@
 #include "component/damage/strikes_pipeline.hpp"
 #include "component/effect/is_effect.hpp"
 #include "component/effect/is_unique_effect.hpp"
-#include "component/effect/source_actor.hpp"
 #include "component/hierarchy/owner_component.hpp"
 
+#include "utils/actor_utils.hpp"
 #include "utils/condition_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
 
 namespace gw2combat::system {
 
@@ -25,8 +26,8 @@ void dispatch_strikes(registry_t& registry) {
                             return;
                         }
                         auto& incoming_strikes_component =
-                            registry.get_or_emplace<component::incoming_strikes_component>(
-                                other_entity);
+                            utils::get_or_emplace_frame_component<
+                                component::incoming_strikes_component>(other_entity, registry);
                         incoming_strikes_component.strikes.emplace_back(component::incoming_strike{
                             utils::get_owner(source_entity, registry), this_strike});
                         --this_strike.num_targets;
@@ -43,31 +44,32 @@ void dispatch_effects(registry_t& registry) {
             entity_t actual_source_entity = [&]() {
                 if (registry.any_of<component::is_effect, component::is_unique_effect>(
                         source_entity)) {
-                    return registry.get<component::source_actor>(source_entity).entity;
+                    return utils::get_effect_source_actor(source_entity, registry);
                 }
                 return utils::get_owner(source_entity, registry);
             }();
             for (component::effect_application_t application :
                  outgoing_effects_component.effect_applications) {
+                auto& application_condition =
+                    utils::get_effect_application_configuration(application, registry).condition;
                 if (application.direction == component::effect_application_t::direction_t::SELF) {
-                    if (!utils::independent_conditions_satisfied(application.condition,
-                                                                 actual_source_entity,
-                                                                 actual_source_entity,
-                                                                 registry)
-                             .satisfied) {
+                    if (!utils::are_independent_conditions_satisfied(application_condition,
+                                                                     actual_source_entity,
+                                                                     actual_source_entity,
+                                                                     registry)) {
                         continue;
                     }
 
                     auto& incoming_effects_component =
-                        registry.get_or_emplace<component::incoming_effects_component>(
-                            actual_source_entity);
+                        utils::get_or_emplace_frame_component<
+                            component::incoming_effects_component>(actual_source_entity, registry);
                     incoming_effects_component.effect_applications.emplace_back(
                         component::incoming_effect_application{source_entity, application});
                 } else if (application.direction ==
                            component::effect_application_t::direction_t::TEAM) {
                     auto& incoming_effects_component =
-                        registry.get_or_emplace<component::incoming_effects_component>(
-                            actual_source_entity);
+                        utils::get_or_emplace_frame_component<
+                            component::incoming_effects_component>(actual_source_entity, registry);
                     incoming_effects_component.effect_applications.emplace_back(
                         component::incoming_effect_application{source_entity, application});
                     --application.num_targets;
@@ -76,17 +78,17 @@ void dispatch_effects(registry_t& registry) {
                         .each([&](entity_t other_entity, const component::team& other_team) {
                             if (application.num_targets <= 0 || other_entity == source_entity ||
                                 other_team.id != source_team.id ||
-                                !utils::independent_conditions_satisfied(application.condition,
-                                                                         actual_source_entity,
-                                                                         other_entity,
-                                                                         registry)
-                                     .satisfied) {
+                                !utils::are_independent_conditions_satisfied(
+                                    application_condition,
+                                    actual_source_entity,
+                                    other_entity,
+                                    registry)) {
                                 return;
                             }
 
                             auto& incoming_effects_component =
-                                registry.get_or_emplace<component::incoming_effects_component>(
-                                    other_entity);
+                                utils::get_or_emplace_frame_component<
+                                    component::incoming_effects_component>(other_entity, registry);
                             incoming_effects_component.effect_applications.emplace_back(
                                 component::incoming_effect_application{source_entity, application});
                             --application.num_targets;
@@ -96,17 +98,17 @@ void dispatch_effects(registry_t& registry) {
                     registry.view<component::team>(entt::exclude<component::owner_component>)
                         .each([&](entity_t other_entity, const component::team& other_team) {
                             if (application.num_targets <= 0 || other_team.id == source_team.id ||
-                                !utils::independent_conditions_satisfied(application.condition,
-                                                                         actual_source_entity,
-                                                                         other_entity,
-                                                                         registry)
-                                     .satisfied) {
+                                !utils::are_independent_conditions_satisfied(
+                                    application_condition,
+                                    actual_source_entity,
+                                    other_entity,
+                                    registry)) {
                                 return;
                             }
 
                             auto& incoming_effects_component =
-                                registry.get_or_emplace<component::incoming_effects_component>(
-                                    other_entity);
+                                utils::get_or_emplace_frame_component<
+                                    component::incoming_effects_component>(other_entity, registry);
                             incoming_effects_component.effect_applications.emplace_back(
                                 component::incoming_effect_application{source_entity, application});
                             --application.num_targets;
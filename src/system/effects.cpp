@@ -1,5 +1,8 @@
 #include "effects.hpp"
 
+#include <map>
+#include <tuple>
+
 #include "common.hpp"
 
 #include "component/actor/is_actor.hpp"
@@ -7,16 +10,17 @@
 #include "component/damage/buffered_condition_damage.hpp"
 #include "component/damage/incoming_damage.hpp"
 #include "component/effect/is_effect.hpp"
-#include "component/effect/source_actor.hpp"
-#include "component/effect/source_skill.hpp"
 #include "component/hierarchy/owner_component.hpp"
 #include "component/temporal/duration_component.hpp"
 
 #include "system/attributes.hpp"
 
+#include "utils/actor_utils.hpp"
 #include "utils/effect_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
 #include "utils/skill_utils.hpp"
+#include "utils/temporal_utils.hpp"
 
 namespace gw2combat::system {
 
@@ -66,10 +70,12 @@ double calculate_condition_damage(actor::effect_t this_effect,
     }
 }
 
-void buffer_condition_damage(registry_t& registry,
-                             entity_t target_entity,
-                             entity_t effect_entity,
-                             entity_t effect_source_entity) {
+// The damage of one stack of the effect over a full second, which is the same for every stack
+// that the source actor applied to the target.
+double calculate_base_condition_damage(registry_t& registry,
+                                       actor::effect_t this_effect,
+                                       entity_t target_entity,
+                                       entity_t effect_source_entity) {
     auto& source_relative_attributes =
         registry.get<component::relative_attributes>(effect_source_entity);
     auto& target_relative_attributes = registry.get<component::relative_attributes>(target_entity);
@@ -85,15 +91,21 @@ void buffer_condition_damage(registry_t& registry,
         (1.0 + target_relative_attributes.get(
                    effect_source_entity,
                    actor::attribute_t::INCOMING_CONDITION_DAMAGE_MULTIPLIER_ADD_GROUP));
+    return calculate_condition_damage(
+        this_effect, target_entity, source_relative_attributes, base_condition_damage_multiplier);
+}
 
+void buffer_condition_damage(registry_t& registry,
+                             entity_t target_entity,
+                             entity_t effect_entity,
+                             entity_t effect_source_entity,
+                             double base_condition_damage) {
     auto& condition_duration = registry.get<component::duration_component>(effect_entity);
-    double damaging_condition_progress_multiplier = condition_duration.progress / 1'000.0;
-    condition_duration.duration -= condition_duration.progress;
-    condition_duration.progress = 0;
+    int condition_progress = utils::get_duration_progress(condition_duration, registry);
+    double damaging_condition_progress_multiplier = condition_progress / 1'000.0;
+    utils::set_duration(
+        effect_entity, condition_duration.duration - condition_progress, 0, registry);
     auto& is_effect = registry.get<component::is_effect>(effect_entity);
-    auto& this_effect = is_effect.effect;
-    double base_condition_damage = calculate_condition_damage(
-        this_effect, target_entity, source_relative_attributes, base_condition_damage_multiplier);
     double effective_condition_damage =
         utils::round_to_nearest_even(base_condition_damage *
                                      damaging_condition_progress_multiplier *
@@ -101,34 +113,13 @@ void buffer_condition_damage(registry_t& registry,
         (double)is_effect.grouped_with_num_stacks;
 
     auto& buffered_condition_damage =
-        registry.get_or_emplace<component::buffered_condition_damage>(target_entity);
+        utils::get_or_emplace_frame_component<component::buffered_condition_damage>(
+            target_entity, registry);
     buffered_condition_damage.condition_damage_buffer.emplace_back(component::condition_damage_t{
         .effect_source_entity = effect_source_entity,
-        .effect = this_effect,
-        .source_skill = registry.get<component::source_skill>(effect_entity).skill,
+        .effect = is_effect.effect,
+        .source_skill = utils::get_effect_source_skill(effect_entity, registry),
         .damage = effective_condition_damage});
-
-    // double total_buffered_damage = std::accumulate(
-    //     buffered_condition_damage.condition_damage_buffer.begin(),
-    //     buffered_condition_damage.condition_damage_buffer.end(),
-    //     0.0,
-    //     [](double accumulated, const component::condition_damage_t& condition_damage) {
-    //         return accumulated + condition_damage.damage;
-    //     });
-    // spdlog::info(
-    //     "[{}] {}:effect {}:{} condi_dmg {} base_mult {} progress_mult {} base_dmg {} eff_dmg {} "
-    //     "buffered_dmg {}",
-    //     utils::get_current_tick(registry),
-    //     utils::get_entity_name(target_entity, registry),
-    //     registry.get<component::source_skill>(effect_entity).skill,
-    //     utils::to_string(this_effect),
-    //     registry.get<component::relative_attributes>(effect_source_entity)
-    //         .get(target_entity, actor::attribute_t::CONDITION_DAMAGE),
-    //     base_condition_damage_multiplier,
-    //     damaging_condition_progress_multiplier,
-    //     base_condition_damage,
-    //     effective_condition_damage,
-    //     utils::round_to_nearest_even(total_buffered_damage));
 }
 
 void buffer_condition_damage(registry_t& registry, std::optional<entity_t> specific_effect_entity) {
@@ -141,19 +132,40 @@ void buffer_condition_damage(registry_t& registry, std::optional<entity_t> speci
         entity_t target_entity =
             registry.get<component::owner_component>(*specific_effect_entity).entity;
         entity_t effect_source_entity =
-            registry.get<component::source_actor>(*specific_effect_entity).entity;
+            utils::get_effect_source_actor(*specific_effect_entity, registry);
+        auto effect = registry.get<component::is_effect>(*specific_effect_entity).effect;
         buffer_condition_damage(
-            registry, target_entity, *specific_effect_entity, effect_source_entity);
+            registry,
+            target_entity,
+            *specific_effect_entity,
+            effect_source_entity,
+            calculate_base_condition_damage(registry, effect, target_entity, effect_source_entity));
     } else {
+        // Stacks are still buffered one by one, in the order of the view, but the base damage is
+        // only calculated once for every target, source actor and effect.
+        std::map<std::tuple<entity_t, entity_t, actor::effect_t>, double>
+            base_condition_damage_by_source;
         registry
-            .view<component::is_damaging_effect,
-                  component::owner_component,
-                  component::source_actor>()
+            .view<component::is_damaging_effect, component::owner_component, component::is_effect>()
             .each([&](entity_t effect_entity,
                       const component::owner_component& owner_component,
-                      const component::source_actor& source_actor) {
-                buffer_condition_damage(
-                    registry, owner_component.entity, effect_entity, source_actor.entity);
+                      const component::is_effect& is_effect) {
+                auto effect_source_entity = utils::get_effect_source_actor(effect_entity, registry);
+                auto [base_condition_damage, inserted] =
+                    base_condition_damage_by_source.try_emplace(
+                        {owner_component.entity, effect_source_entity, is_effect.effect});
+                if (inserted) {
+                    base_condition_damage->second =
+                        calculate_base_condition_damage(registry,
+                                                        is_effect.effect,
+                                                        owner_component.entity,
+                                                        effect_source_entity);
+                }
+                buffer_condition_damage(registry,
+                                        owner_component.entity,
+                                        effect_entity,
+                                        effect_source_entity,
+                                        base_condition_damage->second);
             });
     }
 }
@@ -162,16 +174,18 @@ void apply_condition_damage(registry_t& registry) {
     registry.view<component::buffered_condition_damage>().each(
         [&](entity_t entity,
             const component::buffered_condition_damage& buffered_condition_damage) {
-            auto& incoming_damage = registry.get_or_emplace<component::incoming_damage>(entity);
+            auto& incoming_damage =
+                utils::get_or_emplace_frame_component<component::incoming_damage>(entity, registry);
             for (auto& condition_damage : buffered_condition_damage.condition_damage_buffer) {
                 incoming_damage.incoming_damage_events.emplace_back(
-                    component::incoming_damage_event{utils::get_current_tick(registry),
-                                                     condition_damage.effect_source_entity,
-                                                     condition_damage.effect,
-                                                     condition_damage.source_skill,
-                                                     condition_damage.damage});
+                    component::incoming_damage_event{
+                        utils::get_current_tick(registry),
+                        condition_damage.effect_source_entity,
+                        condition_damage.effect,
+                        condition_damage.source_skill,
+                        condition_damage.damage});
             }
-            registry.remove<component::buffered_condition_damage>(entity);
+            utils::remove_frame_component<component::buffered_condition_damage>(entity, registry);
         });
 }
 
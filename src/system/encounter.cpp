@@ -2,6 +2,9 @@
 
 #include "audit.hpp"
 
+#include "frame_buffers.hpp"
+#include "skill_configuration_table.hpp"
+
 #include "actor/rotation.hpp"
 
 #include "component/actor/base_class_component.hpp"
@@ -20,6 +23,8 @@
 #include "configuration/encounter.hpp"
 
 #include "utils/actor_utils.hpp"
+#include "utils/condition_utils.hpp"
+#include "utils/entity_utils.hpp"
 #include "utils/io_utils.hpp"
 
 namespace gw2combat::system {
@@ -40,10 +45,12 @@ void add_recipe_items_to_actor(
         }
 
         auto counter_entity = registry.create();
-        registry.emplace<component::owner_component>(counter_entity, actor_entity);
+        utils::set_owner(counter_entity, actor_entity, registry);
         registry.emplace<component::is_counter>(
             counter_entity,
-            component::is_counter{counter_configuration.initial_value, counter_configuration});
+            component::is_counter{counter_configuration.initial_value,
+                                  counter_configuration,
+                                  utils::get_symbol(counter_configuration.counter_key, registry)});
         utils::add_owner_based_component<std::vector<configuration::counter_modifier_t>,
                                          component::is_counter_modifier_t>(
             counter_configuration.counter_modifiers, actor_entity, registry);
@@ -64,11 +71,48 @@ void add_recipe_items_to_actor(
     }
 }
 
-void setup_encounter(registry_t& registry, const configuration::encounter_t& encounter) {
+void setup_rotation(registry_t& registry,
+                    entity_t actor_entity,
+                    const configuration::rotation_t& rotation) {
+    if (rotation.skill_casts.empty()) {
+        registry.remove<component::rotation_component>(actor_entity);
+        return;
+    }
+    actor::rotation_t converted_rotation{};
+    int offset = 0;
+    bool first = true;
+    for (auto&& skill_cast : rotation.skill_casts) {
+        if (first) {
+            offset = std::min(skill_cast.cast_time_ms, tick_t{0});
+            first = false;
+        }
+        converted_rotation.skill_casts.emplace_back(
+            actor::skill_cast_t{skill_cast.skill, (tick_t)(skill_cast.cast_time_ms - offset)});
+    }
+    registry.emplace_or_replace<component::rotation_component>(
+        actor_entity, component::rotation_component{converted_rotation, 0, 0, rotation.repeat});
+}
+
+void setup_encounter(registry_t& registry,
+                     const configuration::encounter_t& encounter_configuration) {
+    registry.ctx().emplace<symbol_table_t>();
+    registry.ctx().emplace<std::shared_ptr<skill_configuration_table_t>>(
+        std::make_shared<skill_configuration_table_t>());
+    registry.ctx().emplace<temporal_schedule_t>();
+    registry.ctx().emplace<frame_buffers_t>();
+
+    // Everything below copies its configuration from the registry's own copy of the encounter, so
+    // its conditions are compiled once and the copies share the programs.
+    auto compiled_encounter =
+        std::make_shared<configuration::encounter_t>(encounter_configuration);
+    utils::compile_conditions(*compiled_encounter, registry);
+    auto& encounter = *compiled_encounter;
+
     auto singleton_entity = registry.create();
     registry.ctx().emplace_as<std::string>(singleton_entity, "Console");
 
-    registry.emplace<component::encounter_configuration_component>(singleton_entity, encounter);
+    registry.emplace<component::encounter_configuration_component>(singleton_entity,
+                                                                   compiled_encounter);
     registry.emplace<component::is_actor>(singleton_entity);
     registry.emplace<component::static_attributes>(
         singleton_entity, component::static_attributes{configuration::build_t{}.attributes});
@@ -78,6 +122,8 @@ void setup_encounter(registry_t& registry, const configuration::encounter_t& enc
         component::audit_component{
             .audit_configuration = encounter.audit_configuration,
             .events = {},
+            .afk_ticks_by_actor = {},
+            .shared_events = {},
         });
     // NOTE: This system is responsible for its own audit because it doesn't run in the combat loop
     audit_component.events.emplace_back(
@@ -114,6 +160,7 @@ void setup_encounter(registry_t& registry, const configuration::encounter_t& enc
         }
         for (auto& recipe_path : build.recipe_paths) {
             auto recipe = utils::read<configuration::recipe_t>(recipe_path);
+            utils::compile_conditions(recipe, registry);
             add_recipe_items_to_actor(recipe.counters,
                                       recipe.permanent_effects,
                                       recipe.permanent_unique_effects,
@@ -130,22 +177,7 @@ void setup_encounter(registry_t& registry, const configuration::encounter_t& enc
                                   actor_entity,
                                   registry);
 
-        if (!actor.rotation.skill_casts.empty()) {
-            actor::rotation_t converted_rotation{};
-            int offset = 0;
-            bool first = true;
-            for (auto&& skill_cast : actor.rotation.skill_casts) {
-                if (first) {
-                    offset = std::min(skill_cast.cast_time_ms, tick_t{0});
-                    first = false;
-                }
-                converted_rotation.skill_casts.emplace_back(actor::skill_cast_t{
-                    skill_cast.skill, (tick_t)(skill_cast.cast_time_ms - offset)});
-            }
-            registry.emplace<component::rotation_component>(
-                actor_entity,
-                component::rotation_component{converted_rotation, 0, 0, actor.rotation.repeat});
-        }
+        setup_rotation(registry, actor_entity, actor.rotation);
 
         audit_component.events.emplace_back(
             create_tick_event(audit::actor_created_event_t{}, actor_entity, registry));
@@ -9,6 +9,12 @@ namespace gw2combat::system {
 
 extern void setup_encounter(registry_t& registry, const configuration::encounter_t& encounter);
 
+// Gives the actor the rotation, replacing any rotation it already has. An empty rotation leaves the
+// actor without one.
+extern void setup_rotation(registry_t& registry,
+                           entity_t actor_entity,
+                           const configuration::rotation_t& rotation);
+
 }  // namespace gw2combat::system
 
 #endif  // GW2COMBAT_SYSTEM_ENCOUNTER_HPP
@@ -14,9 +14,11 @@
 #include "component/skill/is_conditional_skill_group.hpp"
 #include "component/skill/is_skill.hpp"
 #include "component/temporal/animation_component.hpp"
+#include "component/temporal/has_quickness.hpp"
 
 #include "utils/actor_utils.hpp"
 #include "utils/entity_utils.hpp"
+#include "utils/frame_utils.hpp"
 #include "utils/skill_utils.hpp"
 #include "utils/weapon_utils.hpp"
 
@@ -25,7 +27,7 @@ namespace gw2combat::system {
 bool perform_rotations(registry_t& registry) {
     bool at_least_one_rotation_performed = false;
     auto& encounter =
-        registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
+        *registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
             .encounter;
     registry.view<component::rotation_component>(entt::exclude<component::no_more_rotation>)
         .each([&](entity_t entity, component::rotation_component& rotation_component) {
@@ -49,9 +51,9 @@ bool perform_rotations(registry_t& registry) {
                     rotation_component.tick_offset = current_tick;
                 } else {
                     registry.emplace<component::no_more_rotation>(entity);
-                    spdlog::info("[{}] {} has no more rotation",
-                                 utils::get_current_tick(registry),
-                                 utils::get_entity_name(entity, registry));
+                    GW2COMBAT_TRACE("[{}] {} has no more rotation",
+                                    utils::get_current_tick(registry),
+                                    utils::get_entity_name(entity, registry));
                     return;
                 }
             }
@@ -69,8 +71,7 @@ bool perform_rotations(registry_t& registry) {
 
             auto skill_entity = utils::get_skill_entity(next_skill_cast.skill, entity, registry);
 
-            auto& skill_configuration =
-                registry.get<component::is_skill>(skill_entity).skill_configuration;
+            auto& skill_configuration = utils::get_skill_configuration(skill_entity, registry);
             bool is_instant_cast_skill = skill_configuration.cast_duration[0] == 0;
             bool is_in_animation = registry.any_of<component::animation_component>(entity);
             if ((!is_instant_cast_skill ||
@@ -106,8 +107,7 @@ bool perform_rotations(registry_t& registry) {
                     }
                     for (auto& iter_skill_state : iter_skills_actions_component.skills) {
                         auto& iter_skill_configuration =
-                            registry.get<component::is_skill>(iter_skill_state.skill_entity)
-                                .skill_configuration;
+                            utils::get_skill_configuration(iter_skill_state.skill_entity, registry);
                         if (iter_skill_configuration.skill_key != skill_to_cancel) {
                             continue;
                         }
@@ -121,7 +121,7 @@ bool perform_rotations(registry_t& registry) {
                                 return skill_state.skill_entity == skill_to_cancel_entity;
                             });
                         if (skill_to_cancel_pos != iter_skills_actions_component.skills.cend()) {
-                            spdlog::info(
+                            GW2COMBAT_TRACE(
                                 "[{}] {}:{} Canceling skill {} for {}",
                                 utils::get_current_tick(registry),
                                 utils::get_entity_name(utils::get_owner(entity, registry),
@@ -156,7 +156,8 @@ bool perform_rotations(registry_t& registry) {
                     weapon_strength_roll,
                 });
             auto& begun_casting_skills_component =
-                registry.get_or_emplace<component::begun_casting_skills>(entity);
+                utils::get_or_emplace_frame_component<component::begun_casting_skills>(
+                    entity, registry);
             begun_casting_skills_component.skill_entities.emplace_back(skill_entity);
 
             if (has_queued_rotation) {
@@ -166,11 +167,11 @@ bool perform_rotations(registry_t& registry) {
             }
 
             if (is_instant_cast_skill) {
-                spdlog::info("[{}] {} casting instant skill {} rotation index {}",
-                             utils::get_current_tick(registry),
-                             utils::get_entity_name(entity, registry),
-                             utils::to_string(skill_configuration.skill_key),
-                             rotation_component.current_idx);
+                GW2COMBAT_TRACE("[{}] {} casting instant skill {} rotation index {}",
+                                utils::get_current_tick(registry),
+                                utils::get_entity_name(entity, registry),
+                                utils::to_string(skill_configuration.skill_key),
+                                rotation_component.current_idx);
                 utils::finish_casting_skill(skill_entity, entity, registry);
             } else {
                 registry.emplace<component::animation_component>(
@@ -178,68 +179,99 @@ bool perform_rotations(registry_t& registry) {
                     component::animation_component{
                         skill_entity, skill_configuration.cast_duration, {0, 0}});
                 if (has_queued_rotation) {
-                    spdlog::info("[{}] {} casting skill {} queued rotation at index {}",
-                                 utils::get_current_tick(registry),
-                                 utils::get_entity_name(entity, registry),
-                                 utils::to_string(skill_configuration.skill_key),
-                                 rotation_component.current_idx);
+                    GW2COMBAT_TRACE("[{}] {} casting skill {} queued rotation at index {}",
+                                    utils::get_current_tick(registry),
+                                    utils::get_entity_name(entity, registry),
+                                    utils::to_string(skill_configuration.skill_key),
+                                    rotation_component.current_idx);
                 } else {
-                    spdlog::info("[{}] {} casting skill {} rotation index {}",
-                                 utils::get_current_tick(registry),
-                                 utils::get_entity_name(entity, registry),
-                                 utils::to_string(skill_configuration.skill_key),
-                                 rotation_component.current_idx);
+                    GW2COMBAT_TRACE("[{}] {} casting skill {} rotation index {}",
+                                    utils::get_current_tick(registry),
+                                    utils::get_entity_name(entity, registry),
+                                    utils::to_string(skill_configuration.skill_key),
+                                    rotation_component.current_idx);
                 }
             }
         });
     return at_least_one_rotation_performed;
 }
 
+struct action_progress_t {
+    double effective_progress_pct;
+    int effective_tick;
+};
+
+action_progress_t get_action_progress(const std::array<std::vector<int>, 2>& on_tick_list,
+                                      const std::array<int, 2>& cast_duration,
+                                      const std::array<int, 2>& action_progress) {
+    int no_quickness_duration =
+        std::max(on_tick_list[0].empty() ? 0 : on_tick_list[0].back(), cast_duration[0]);
+    int quickness_duration =
+        std::max(on_tick_list[1].empty() ? 0 : on_tick_list[1].back(), cast_duration[1]);
+    double no_quickness_progress_pct = no_quickness_duration == 0.0
+                                           ? 100.0
+                                           : (action_progress[0] * 100.0) / no_quickness_duration;
+    double quickness_progress_pct =
+        quickness_duration == 0.0 ? 100.0 : (action_progress[1] * 100.0) / quickness_duration;
+    double effective_progress_pct = no_quickness_progress_pct + quickness_progress_pct;
+    return {effective_progress_pct,
+            utils::round_down(no_quickness_duration * effective_progress_pct / 100.0)};
+}
+
+// Returns whether perform_skills would emit an action or finish the skill at the given progress.
+bool skill_action_due(const configuration::skill_t& skill_configuration,
+                      const component::skills_actions_component::skill_state_t& skill_state,
+                      const std::array<int, 2>& action_progress) {
+    auto action_due = [&](const std::array<std::vector<int>, 2>& on_tick_list, int next_idx) {
+        auto progress =
+            get_action_progress(on_tick_list, skill_configuration.cast_duration, action_progress);
+        bool next_action_due = next_idx < static_cast<int>(on_tick_list[0].size()) &&
+                               progress.effective_tick >= on_tick_list[0][next_idx];
+        return std::make_pair(next_action_due, progress.effective_progress_pct >= 100.0);
+    };
+    auto [pulse_due, pulse_finished] =
+        action_due(skill_configuration.pulse_on_tick_list, skill_state.next_pulse_idx);
+    auto [strike_due, strike_finished] =
+        action_due(skill_configuration.strike_on_tick_list, skill_state.next_strike_idx);
+    auto [whirl_due, whirl_finished] =
+        action_due(skill_configuration.whirl_finisher_on_tick_list, skill_state.next_whirl_idx);
+    return pulse_due || strike_due || whirl_due ||
+           (pulse_finished && strike_finished && whirl_finished);
+}
+
 void perform_skills(registry_t& registry) {
     registry.view<component::skills_actions_component>().each(
         [&](entity_t entity, component::skills_actions_component& casting_skills_component) {
             for (auto& casting_skill : casting_skills_component.skills) {
+                auto skill_handle =
+                    registry.get<component::is_skill>(casting_skill.skill_entity).skill_handle;
                 auto& skill_configuration =
-                    registry.get<component::is_skill>(casting_skill.skill_entity)
-                        .skill_configuration;
-
-                int pulse_no_quickness_duration =
-                    std::max(skill_configuration.pulse_on_tick_list[0].empty()
-                                 ? 0
-                                 : skill_configuration.pulse_on_tick_list[0].back(),
-                             skill_configuration.cast_duration[0]);
-                int pulse_quickness_duration =
-                    std::max(skill_configuration.pulse_on_tick_list[1].empty()
-                                 ? 0
-                                 : skill_configuration.pulse_on_tick_list[1].back(),
-                             skill_configuration.cast_duration[1]);
-                double pulse_no_quickness_progress_pct =
-                    pulse_no_quickness_duration == 0.0
-                        ? 100.0
-                        : (casting_skill.action_progress[0] * 100.0) / pulse_no_quickness_duration;
-                double pulse_quickness_progress_pct =
-                    pulse_quickness_duration == 0.0
-                        ? 100.0
-                        : (casting_skill.action_progress[1] * 100.0) / pulse_quickness_duration;
-                double pulse_effective_progress_pct =
-                    pulse_no_quickness_progress_pct + pulse_quickness_progress_pct;
-                int pulse_effective_tick = utils::round_down(pulse_no_quickness_duration *
-                                                             pulse_effective_progress_pct / 100.0);
+                    utils::get_skill_configuration_table(registry).get(skill_handle);
+
+                auto pulse_progress =
+                    get_action_progress(skill_configuration.pulse_on_tick_list,
+                                        skill_configuration.cast_duration,
+                                        casting_skill.action_progress);
                 while (
                     casting_skill.next_pulse_idx <
                         static_cast<int>(skill_configuration.pulse_on_tick_list[0].size()) &&
-                    pulse_effective_tick >=
+                    pulse_progress.effective_tick >=
                         skill_configuration.pulse_on_tick_list[0][casting_skill.next_pulse_idx]) {
                     auto& outgoing_effects_component =
-                        registry.get_or_emplace<component::outgoing_effects_component>(entity);
-                    for (auto& effect_application :
-                         skill_configuration.on_pulse_effect_applications) {
+                        utils::get_or_emplace_frame_component<
+                            component::outgoing_effects_component>(entity, registry);
+                    auto& effect_applications = skill_configuration.on_pulse_effect_applications;
+                    for (std::size_t application_idx = 0;
+                         application_idx < effect_applications.size();
+                         ++application_idx) {
+                        auto& effect_application = effect_applications[application_idx];
                         outgoing_effects_component.effect_applications.emplace_back(
                             component::effect_application_t{
-                                .condition = effect_application.condition,
-                                .source_skill = skill_configuration.skill_key,
+                                .skill_handle = skill_handle,
+                                .skill_action =
+                                    component::effect_application_t::skill_action_t::PULSE,
+                                .application_idx = static_cast<std::uint32_t>(application_idx),
                                 .effect = effect_application.effect,
-                                .unique_effect = effect_application.unique_effect,
                                 .direction = component::effect_application_t::convert_direction(
                                     effect_application.direction),
                                 .base_duration_ms = effect_application.base_duration_ms,
@@ -249,35 +281,18 @@ void perform_skills(registry_t& registry) {
                     ++casting_skill.next_pulse_idx;
                 }
 
-                int strike_no_quickness_duration =
-                    std::max(skill_configuration.strike_on_tick_list[0].empty()
-                                 ? 0
-                                 : skill_configuration.strike_on_tick_list[0].back(),
-                             skill_configuration.cast_duration[0]);
-                int strike_quickness_duration =
-                    std::max(skill_configuration.strike_on_tick_list[1].empty()
-                                 ? 0
-                                 : skill_configuration.strike_on_tick_list[1].back(),
-                             skill_configuration.cast_duration[1]);
-                double strike_no_quickness_progress_pct =
-                    strike_no_quickness_duration == 0.0
-                        ? 100.0
-                        : (casting_skill.action_progress[0] * 100.0) / strike_no_quickness_duration;
-                double strike_quickness_progress_pct =
-                    strike_quickness_duration == 0.0
-                        ? 100.0
-                        : (casting_skill.action_progress[1] * 100.0) / strike_quickness_duration;
-                double strike_effective_progress_pct =
-                    strike_no_quickness_progress_pct + strike_quickness_progress_pct;
-                int strike_effective_tick = utils::round_down(
-                    strike_no_quickness_duration * strike_effective_progress_pct / 100.0);
+                auto strike_progress =
+                    get_action_progress(skill_configuration.strike_on_tick_list,
+                                        skill_configuration.cast_duration,
+                                        casting_skill.action_progress);
                 while (
                     casting_skill.next_strike_idx <
                         static_cast<int>(skill_configuration.strike_on_tick_list[0].size()) &&
-                    strike_effective_tick >=
+                    strike_progress.effective_tick >=
                         skill_configuration.strike_on_tick_list[0][casting_skill.next_strike_idx]) {
                     auto& outgoing_strikes_component =
-                        registry.get_or_emplace<component::outgoing_strikes_component>(entity);
+                        utils::get_or_emplace_frame_component<
+                            component::outgoing_strikes_component>(entity, registry);
                     auto this_strike = component::strike_t{casting_skill.skill_entity,
                                                            skill_configuration.num_targets,
                                                            casting_skill.weapon_strength_roll};
@@ -285,32 +300,14 @@ void perform_skills(registry_t& registry) {
                     ++casting_skill.next_strike_idx;
                 }
 
-                int whirl_no_quickness_duration =
-                    std::max(skill_configuration.whirl_finisher_on_tick_list[0].empty()
-                                 ? 0
-                                 : skill_configuration.whirl_finisher_on_tick_list[0].back(),
-                             skill_configuration.cast_duration[0]);
-                int whirl_quickness_duration =
-                    std::max(skill_configuration.whirl_finisher_on_tick_list[1].empty()
-                                 ? 0
-                                 : skill_configuration.whirl_finisher_on_tick_list[1].back(),
-                             skill_configuration.cast_duration[1]);
-                double whirl_no_quickness_progress_pct =
-                    whirl_no_quickness_duration == 0.0
-                        ? 100.0
-                        : (casting_skill.action_progress[0] * 100.0) / whirl_no_quickness_duration;
-                double whirl_quickness_progress_pct =
-                    whirl_quickness_duration == 0.0
-                        ? 100.0
-                        : (casting_skill.action_progress[1] * 100.0) / whirl_quickness_duration;
-                double whirl_effective_progress_pct =
-                    whirl_no_quickness_progress_pct + whirl_quickness_progress_pct;
-                int whirl_effective_tick = utils::round_down(whirl_no_quickness_duration *
-                                                             whirl_effective_progress_pct / 100.0);
+                auto whirl_progress =
+                    get_action_progress(skill_configuration.whirl_finisher_on_tick_list,
+                                        skill_configuration.cast_duration,
+                                        casting_skill.action_progress);
                 while (casting_skill.next_whirl_idx <
                            static_cast<int>(
                                skill_configuration.whirl_finisher_on_tick_list[0].size()) &&
-                       whirl_effective_tick >=
+                       whirl_progress.effective_tick >=
                            skill_configuration
                                .whirl_finisher_on_tick_list[0][casting_skill.next_whirl_idx]) {
                     // NOTE: Eventually maybe want to sort fields cast by us first and then allies
@@ -319,9 +316,8 @@ void perform_skills(registry_t& registry) {
                     for (auto&& [iter_actor_entity, skill_actions_component] :
                          registry.view<component::skills_actions_component>().each()) {
                         for (auto& iter_skill_state : skill_actions_component.skills) {
-                            auto& iter_skill_configuration =
-                                registry.get<component::is_skill>(iter_skill_state.skill_entity)
-                                    .skill_configuration;
+                            auto& iter_skill_configuration = utils::get_skill_configuration(
+                                iter_skill_state.skill_entity, registry);
                             if (iter_skill_configuration.combo_field ==
                                 actor::combo_field_t::INVALID) {
                                 continue;
@@ -342,9 +338,9 @@ void perform_skills(registry_t& registry) {
                     ++casting_skill.next_whirl_idx;
                 }
 
-                if (strike_effective_progress_pct >= 100.0 &&
-                    pulse_effective_progress_pct >= 100.0 &&
-                    whirl_effective_progress_pct >= 100.0) {
+                if (strike_progress.effective_progress_pct >= 100.0 &&
+                    pulse_progress.effective_progress_pct >= 100.0 &&
+                    whirl_progress.effective_progress_pct >= 100.0) {
                     auto& finished_skills_actions_component =
                         registry.get_or_emplace<component::finished_skills_actions_component>(
                             entity);
@@ -394,4 +390,80 @@ void destroy_actors_with_no_rotation(registry_t& registry) {
         });
 }
 
+tick_t get_next_rotation_event_tick(registry_t& registry) {
+    auto current_tick = utils::get_current_tick(registry);
+    tick_t next_event_tick = std::numeric_limits<tick_t>::max();
+    auto& encounter =
+        *registry.get<component::encounter_configuration_component>(utils::get_singleton_entity())
+            .encounter;
+
+    auto actors_to_destroy_view =
+        registry.view<component::destroy_after_rotation, component::no_more_rotation>(
+            entt::exclude<component::finished_skills_actions_component,
+                          component::skills_actions_component>);
+    if (actors_to_destroy_view.begin() != actors_to_destroy_view.end()) {
+        return current_tick + 1;
+    }
+
+    for (auto&& [entity, rotation_component] :
+         registry.view<component::rotation_component>(entt::exclude<component::no_more_rotation>)
+             .each()) {
+        if (!rotation_component.queued_rotation.empty() ||
+            rotation_component.current_idx >=
+                static_cast<int>(rotation_component.rotation.skill_casts.size())) {
+            return current_tick + 1;
+        }
+        auto& next_skill_cast =
+            rotation_component.rotation.skill_casts[rotation_component.current_idx];
+        tick_t cast_tick = next_skill_cast.cast_time_ms + rotation_component.tick_offset;
+        if (cast_tick > current_tick + 1) {
+            next_event_tick = std::min(next_event_tick, cast_tick);
+            continue;
+        }
+
+        // The cast is due, so it only waits on an animation or a cooldown, both of which are
+        // events of their own. Skills resolved through conditional skill groups evaluate their
+        // conditions on every attempt, so those always get stepped through.
+        auto skill_entity = utils::find_skill_entity(
+            utils::find_symbol(next_skill_cast.skill, registry), entity, registry);
+        if (!skill_entity) {
+            return current_tick + 1;
+        }
+        auto& skill_configuration = utils::get_skill_configuration(*skill_entity, registry);
+        bool is_instant_cast_skill = skill_configuration.cast_duration[0] == 0;
+        bool is_in_animation = registry.any_of<component::animation_component>(entity);
+        if ((!is_instant_cast_skill ||
+             skill_configuration.instant_cast_only_when_not_in_animation) &&
+            is_in_animation) {
+            continue;
+        }
+        if (!encounter.require_afk_skills &&
+            registry.get<component::ammo>(*skill_entity).current_ammo <= 0 &&
+            !(skill_configuration.skill_key == "Weapon Swap" &&
+              registry.any_of<component::bundle_component>(entity))) {
+            continue;
+        }
+        return current_tick + 1;
+    }
+
+    for (auto&& [entity, skills_actions_component] :
+         registry.view<component::skills_actions_component>().each()) {
+        int quickness_idx = registry.any_of<component::has_quickness>(entity);
+        for (auto& skill_state : skills_actions_component.skills) {
+            auto& skill_configuration =
+                utils::get_skill_configuration(skill_state.skill_entity, registry);
+            auto action_progress = skill_state.action_progress;
+            for (tick_t tick = current_tick + 1; tick < next_event_tick; ++tick) {
+                ++action_progress[quickness_idx];
+                if (skill_action_due(skill_configuration, skill_state, action_progress)) {
+                    next_event_tick = tick;
+                    break;
+                }
+            }
+        }
+    }
+
+    return next_event_tick;
+}
+
 }  // namespace gw2combat::system
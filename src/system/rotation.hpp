@@ -12,6 +12,10 @@ extern void perform_skills(registry_t& registry);
 extern void cleanup_skill_actions(registry_t& registry);
 extern void destroy_actors_with_no_rotation(registry_t& registry);
 
+// Returns the earliest tick at which a rotation, queued cast or in-progress skill action needs to
+// be processed, or the maximum tick if there is none.
+extern tick_t get_next_rotation_event_tick(registry_t& registry);
+
 }  // namespace gw2combat::system
 
 #endif  // GW2COMBAT_SYSTEM_ROTATION_HPP
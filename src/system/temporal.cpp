@@ -8,6 +8,7 @@
 #include "component/skill/ammo.hpp"
 #include "component/skill/is_skill.hpp"
 #include "component/temporal/animation_component.hpp"
+#include "component/temporal/cooldown_clock.hpp"
 #include "component/temporal/cooldown_component.hpp"
 #include "component/temporal/duration_component.hpp"
 #include "component/temporal/has_alacrity.hpp"
@@ -16,6 +17,7 @@
 #include "utils/actor_utils.hpp"
 #include "utils/condition_utils.hpp"
 #include "utils/side_effect_utils.hpp"
+#include "utils/temporal_utils.hpp"
 
 namespace gw2combat::system {
 
@@ -58,12 +60,11 @@ bool progress_animations(registry_t& registry) {
                 registry.emplace<component::already_finished_casting_skill>(
                     finished_casting_skill_entity);
                 auto& skill_configuration =
-                    registry.get<component::is_skill>(finished_casting_skill_entity)
-                        .skill_configuration;
-                spdlog::info("[{}] {}: finishing skill {}",
-                             utils::get_current_tick(registry),
-                             utils::get_entity_name(actor_entity, registry),
-                             skill_configuration.skill_key);
+                    utils::get_skill_configuration(finished_casting_skill_entity, registry);
+                GW2COMBAT_TRACE("[{}] {}: finishing skill {}",
+                                utils::get_current_tick(registry),
+                                utils::get_entity_name(actor_entity, registry),
+                                skill_configuration.skill_key);
 
                 if (!skill_configuration.equip_bundle.empty()) {
                     registry.emplace<component::bundle_component>(
@@ -71,10 +72,10 @@ bool progress_animations(registry_t& registry) {
                         component::bundle_component{skill_configuration.equip_bundle});
                     registry.emplace_or_replace<component::equipped_bundle>(
                         actor_entity, skill_configuration.equip_bundle);
-                    spdlog::info("[{}] {}: equipped bundle {}",
-                                 utils::get_current_tick(registry),
-                                 utils::get_entity_name(actor_entity, registry),
-                                 skill_configuration.equip_bundle);
+                    GW2COMBAT_TRACE("[{}] {}: equipped bundle {}",
+                                    utils::get_current_tick(registry),
+                                    utils::get_entity_name(actor_entity, registry),
+                                    skill_configuration.equip_bundle);
                 } else if (!skill_configuration.drop_bundle.empty()) {
                     if (auto bundle_ptr =
                             registry.try_get<component::bundle_component>(actor_entity);
@@ -88,10 +89,10 @@ bool progress_animations(registry_t& registry) {
                         registry.emplace_or_replace<component::dropped_bundle>(actor_entity,
                                                                                bundle);
                         registry.remove<component::bundle_component>(actor_entity);
-                        spdlog::info("[{}] {}: dropped bundle {}",
-                                     utils::get_current_tick(registry),
-                                     utils::get_entity_name(actor_entity, registry),
-                                     bundle);
+                        GW2COMBAT_TRACE("[{}] {}: dropped bundle {}",
+                                        utils::get_current_tick(registry),
+                                        utils::get_entity_name(actor_entity, registry),
+                                        bundle);
                     } else {
                         throw std::runtime_error("no bundle on entity");
                     }
@@ -102,10 +103,10 @@ bool progress_animations(registry_t& registry) {
                         registry.emplace_or_replace<component::dropped_bundle>(actor_entity,
                                                                                bundle_ptr->name);
                         registry.remove<component::bundle_component>(actor_entity);
-                        spdlog::info("[{}] {}: dropped bundle {}",
-                                     utils::get_current_tick(registry),
-                                     utils::get_entity_name(actor_entity, registry),
-                                     bundle_ptr->name);
+                        GW2COMBAT_TRACE("[{}] {}: dropped bundle {}",
+                                        utils::get_current_tick(registry),
+                                        utils::get_entity_name(actor_entity, registry),
+                                        bundle_ptr->name);
                     } else {
                         if (!registry.any_of<component::current_weapon_set>(actor_entity)) {
                             throw std::runtime_error("no equipped_weapon_set on entity");
@@ -135,7 +136,10 @@ bool progress_animations(registry_t& registry) {
                     return utils::on_finished_casting_conditions_satisfied(
                         condition, actor_entity, skill_configuration, registry);
                 };
-                utils::apply_side_effects(registry, actor_entity, side_effect_condition_fn);
+                utils::apply_side_effects(registry,
+                                          actor_entity,
+                                          component::side_effect_trigger_t::ON_FINISHED_CASTING,
+                                          side_effect_condition_fn);
 
                 utils::enqueue_child_skills(
                     actor_entity,
@@ -147,52 +151,115 @@ bool progress_animations(registry_t& registry) {
     return at_least_one_animation_progressed;
 }
 
-void progress_cooldowns(registry_t& registry) {
-    registry.view<component::cooldown_component>().each(
-        [&](entity_t entity, component::cooldown_component& cooldown) {
-            if (cooldown.duration[0] == 0) {
-                auto ammo = registry.try_get<component::ammo>(entity);
-                if (ammo) {
-                    ammo->current_ammo = ammo->max_ammo;
-                    registry.emplace<component::ammo_gained>(entity);
-                }
-                registry.emplace<component::cooldown_expired>(entity);
+// Cooldowns progress at the rate of the alacrity that their owner actor had when they last
+// progressed, so the cooldowns of actors whose alacrity changed since are projected again.
+void sync_cooldown_clocks(registry_t& registry) {
+    registry.view<component::cooldown_clock>().each(
+        [&](entity_t actor_entity, component::cooldown_clock& cooldown_clock) {
+            bool has_alacrity = registry.any_of<component::has_alacrity>(actor_entity);
+            if (cooldown_clock.has_alacrity == has_alacrity) {
                 return;
             }
-
-            bool has_alacrity =
-                registry.any_of<component::has_alacrity>(utils::get_owner(entity, registry));
-            cooldown.progress[0] += !has_alacrity;
-            cooldown.progress[1] += has_alacrity;
-
-            int no_alacrity_progress_pct = cooldown.progress[0] * 100 / cooldown.duration[0];
-            int alacrity_progress_pct = cooldown.progress[1] * 100 / cooldown.duration[1];
-
-            if (no_alacrity_progress_pct + alacrity_progress_pct >= 100) {
-                auto ammo = registry.try_get<component::ammo>(entity);
-                if (ammo) {
-                    ++ammo->current_ammo;
-                    registry.emplace<component::ammo_gained>(entity);
-                    if (ammo->current_ammo == ammo->max_ammo) {
-                        registry.emplace<component::cooldown_expired>(entity);
-                    } else {
-                        cooldown.progress = {0, 0};
+            cooldown_clock.has_alacrity = has_alacrity;
+            registry.view<component::cooldown_component>().each(
+                [&](entity_t entity, component::cooldown_component& cooldown) {
+                    if (utils::get_owner(entity, registry) == actor_entity) {
+                        utils::schedule_cooldown(entity, cooldown, registry);
                     }
-                } else {
+                });
+        });
+}
+
+// Pops the timers that expired by the current step of the queue and returns their entities in
+// the order in which a view of the component would have visited them.
+template <typename Component>
+std::vector<entity_t> pop_expired_timers(registry_t& registry, timer_queue_t& timer_queue) {
+    std::vector<entity_t> expired_entities;
+    while (!timer_queue.empty() && timer_queue.top().expiry_step <= timer_queue.step) {
+        auto timer = timer_queue.top();
+        timer_queue.pop();
+        if (!registry.valid(timer.entity)) {
+            continue;
+        }
+        auto component_ptr = registry.try_get<Component>(timer.entity);
+        if (component_ptr && utils::get_expiry_step(*component_ptr) == timer.expiry_step) {
+            expired_entities.emplace_back(timer.entity);
+        }
+    }
+    auto& storage = registry.storage<Component>();
+    std::sort(expired_entities.begin(), expired_entities.end(), [&](entity_t lhs, entity_t rhs) {
+        return storage.index(lhs) > storage.index(rhs);
+    });
+    expired_entities.erase(std::unique(expired_entities.begin(), expired_entities.end()),
+                           expired_entities.end());
+    return expired_entities;
+}
+
+// Drops the timers at the top of the queue that no longer match the expiry of their entity.
+template <typename Component>
+void drop_stale_timers(registry_t& registry, timer_queue_t& timer_queue) {
+    while (!timer_queue.empty()) {
+        auto& timer = timer_queue.top();
+        if (registry.valid(timer.entity)) {
+            auto component_ptr = registry.try_get<Component>(timer.entity);
+            if (component_ptr && utils::get_expiry_step(*component_ptr) == timer.expiry_step) {
+                return;
+            }
+        }
+        timer_queue.pop();
+    }
+}
+
+void progress_cooldowns(registry_t& registry) {
+    sync_cooldown_clocks(registry);
+    auto& cooldowns = utils::get_temporal_schedule(registry).cooldowns;
+    ++cooldowns.step;
+    registry.view<component::cooldown_clock>().each(
+        [&](component::cooldown_clock& cooldown_clock) {
+            ++cooldown_clock.steps[cooldown_clock.has_alacrity];
+        });
+
+    for (auto entity : pop_expired_timers<component::cooldown_component>(registry, cooldowns)) {
+        auto& cooldown = registry.get<component::cooldown_component>(entity);
+        if (cooldown.duration[0] == 0) {
+            auto ammo = registry.try_get<component::ammo>(entity);
+            if (ammo) {
+                ammo->current_ammo = ammo->max_ammo;
+                registry.emplace<component::ammo_gained>(entity);
+            }
+            registry.emplace<component::cooldown_expired>(entity);
+            continue;
+        }
+
+        auto progress = utils::get_cooldown_progress(entity, cooldown, registry);
+        int no_alacrity_progress_pct = progress[0] * 100 / cooldown.duration[0];
+        int alacrity_progress_pct = progress[1] * 100 / cooldown.duration[1];
+
+        if (no_alacrity_progress_pct + alacrity_progress_pct >= 100) {
+            auto ammo = registry.try_get<component::ammo>(entity);
+            if (ammo) {
+                ++ammo->current_ammo;
+                registry.emplace<component::ammo_gained>(entity);
+                if (ammo->current_ammo == ammo->max_ammo) {
                     registry.emplace<component::cooldown_expired>(entity);
+                } else {
+                    utils::set_cooldown_progress(entity, {0, 0}, registry);
                 }
+            } else {
+                registry.emplace<component::cooldown_expired>(entity);
             }
-        });
+        } else {
+            utils::schedule_cooldown(entity, cooldown, registry);
+        }
+    }
 }
 
 void progress_durations(registry_t& registry) {
-    registry.view<component::duration_component>().each(
-        [&](entity_t entity, component::duration_component& duration) {
-            ++duration.progress;
-            if (duration.progress >= duration.duration) {
-                registry.emplace<component::duration_expired>(entity);
-            }
-        });
+    auto& durations = utils::get_temporal_schedule(registry).durations;
+    ++durations.step;
+    for (auto entity : pop_expired_timers<component::duration_component>(registry, durations)) {
+        registry.emplace<component::duration_expired>(entity);
+    }
 }
 
 void progress_casting_skills(registry_t& registry) {
@@ -228,4 +295,55 @@ void cleanup_expired_components(registry_t& registry) {
     });
 }
 
+tick_t get_next_temporal_event_tick(registry_t& registry) {
+    sync_cooldown_clocks(registry);
+    auto current_tick = utils::get_current_tick(registry);
+    tick_t next_event_tick = std::numeric_limits<tick_t>::max();
+    registry.view<component::animation_component>().each(
+        [&](entity_t entity, const component::animation_component& animation) {
+            int quickness_idx =
+                registry.any_of<component::has_quickness>(utils::get_owner(entity, registry));
+            next_event_tick = std::min(
+                next_event_tick,
+                current_tick + utils::ticks_until_progress_completes(
+                                   animation.duration, animation.progress, quickness_idx));
+        });
+    auto& temporal_schedule = utils::get_temporal_schedule(registry);
+    drop_stale_timers<component::cooldown_component>(registry, temporal_schedule.cooldowns);
+    drop_stale_timers<component::duration_component>(registry, temporal_schedule.durations);
+    for (auto timer_queue : {&temporal_schedule.cooldowns, &temporal_schedule.durations}) {
+        if (!timer_queue->empty()) {
+            next_event_tick = std::min(
+                next_event_tick,
+                current_tick + static_cast<tick_t>(std::max<std::int64_t>(
+                                   1, timer_queue->top().expiry_step - timer_queue->step)));
+        }
+    }
+    return next_event_tick;
+}
+
+void progress_idle_ticks(registry_t& registry, int num_ticks) {
+    registry.view<component::animation_component>().each(
+        [&](entity_t entity, component::animation_component& animation) {
+            bool has_quickness =
+                registry.any_of<component::has_quickness>(utils::get_owner(entity, registry));
+            animation.progress[has_quickness] += num_ticks;
+        });
+    sync_cooldown_clocks(registry);
+    auto& temporal_schedule = utils::get_temporal_schedule(registry);
+    temporal_schedule.cooldowns.step += num_ticks;
+    registry.view<component::cooldown_clock>().each(
+        [&](component::cooldown_clock& cooldown_clock) {
+            cooldown_clock.steps[cooldown_clock.has_alacrity] += num_ticks;
+        });
+    temporal_schedule.durations.step += num_ticks;
+    registry.view<component::skills_actions_component>().each(
+        [&](entity_t entity, component::skills_actions_component& casting_skills_component) {
+            bool has_quickness = registry.any_of<component::has_quickness>(entity);
+            for (auto& skill_state : casting_skills_component.skills) {
+                skill_state.action_progress[has_quickness] += num_ticks;
+            }
+        });
+}
+
 }  // namespace gw2combat::system
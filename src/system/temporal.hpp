@@ -12,6 +12,12 @@ extern void progress_durations(registry_t& registry);
 extern void progress_casting_skills(registry_t& registry);
 extern void cleanup_expired_components(registry_t& registry);
 
+// Returns the earliest tick at which an animation, cooldown or duration expires, or the maximum
+// tick if nothing is in progress.
+extern tick_t get_next_temporal_event_tick(registry_t& registry);
+// Advances every in-progress timer by num_ticks ticks in which nothing else happens.
+extern void progress_idle_ticks(registry_t& registry, int num_ticks);
+
 }  // namespace gw2combat::system
 
 #endif  // GW2COMBAT_SYSTEM_TEMPORAL_HPP
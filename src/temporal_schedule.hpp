@@ -0,0 +1,57 @@
+#ifndef GW2COMBAT_TEMPORAL_SCHEDULE_HPP
+#define GW2COMBAT_TEMPORAL_SCHEDULE_HPP
+
+#include <vector>
+
+#include "common.hpp"
+
+namespace gw2combat {
+
+// Timers of entities that expire at a step of a clock, which advances by one for every tick that
+// timers progress. The timers form a min-heap on their expiry step, so every tick only looks at
+// the timers that expire. Timers aren't removed when the timer of their entity changes or goes
+// away. Instead, every timer that is popped is checked against the expiry step that the entity
+// currently has, and dropped if they don't match.
+struct timer_queue_t {
+    struct timer_t {
+        std::int64_t expiry_step = 0;
+        entity_t entity = entt::null;
+    };
+
+    void schedule(entity_t entity, std::int64_t expiry_step) {
+        timers.emplace_back(timer_t{expiry_step, entity});
+        std::push_heap(timers.begin(), timers.end(), expires_later);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return timers.empty();
+    }
+
+    [[nodiscard]] const timer_t& top() const {
+        return timers.front();
+    }
+
+    void pop() {
+        std::pop_heap(timers.begin(), timers.end(), expires_later);
+        timers.pop_back();
+    }
+
+    static bool expires_later(const timer_t& lhs, const timer_t& rhs) {
+        return lhs.expiry_step > rhs.expiry_step;
+    }
+
+    std::int64_t step = 0;
+    std::vector<timer_t> timers;
+};
+
+// Every registry owns a schedule in its context. Cooldowns progress at different rates with and
+// without alacrity, so their expiry steps are projected from the alacrity their owner actor has,
+// and projected again whenever that changes.
+struct temporal_schedule_t {
+    timer_queue_t cooldowns;
+    timer_queue_t durations;
+};
+
+}  // namespace gw2combat
+
+#endif  // GW2COMBAT_TEMPORAL_SCHEDULE_HPP
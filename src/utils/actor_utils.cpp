@@ -1,10 +1,14 @@
 #include "actor_utils.hpp"
 
+#include <limits>
+#include <ranges>
+
 #include "common.hpp"
 
 #include "effect_utils.hpp"
 #include "entity_utils.hpp"
 #include "skill_utils.hpp"
+#include "temporal_utils.hpp"
 
 #include "actor/rotation.hpp"
 
@@ -23,6 +27,7 @@
 #include "component/attributes/is_attribute_conversion.hpp"
 #include "component/attributes/is_attribute_modifier.hpp"
 #include "component/counter/is_counter_modifier.hpp"
+#include "component/effect/effect_stacks.hpp"
 #include "component/effect/is_effect.hpp"
 #include "component/effect/is_effect_removal.hpp"
 #include "component/effect/is_skill_trigger.hpp"
@@ -34,6 +39,7 @@
 #include "component/skill/ammo.hpp"
 #include "component/skill/is_conditional_skill_group.hpp"
 #include "component/skill/is_skill.hpp"
+#include "component/skill/skill_table.hpp"
 #include "component/temporal/duration_component.hpp"
 #include "component/temporal/has_alacrity.hpp"
 #include "component/temporal/has_quickness.hpp"
@@ -48,8 +54,7 @@ entity_t create_temporary_rotation_child_actor(entity_t parent_actor,
     registry.ctx().emplace_as<std::string>(
         child_actor_entity, fmt::format("child_actor{}-{}", child_actor_entity, name));
     registry.emplace<component::is_actor>(child_actor_entity);
-    registry.emplace<component::owner_component>(child_actor_entity,
-                                                 utils::get_owner(parent_actor, registry));
+    utils::set_owner(child_actor_entity, utils::get_owner(parent_actor, registry), registry);
     registry.emplace<component::team>(child_actor_entity, team_id);
     registry.emplace<component::destroy_after_rotation>(child_actor_entity);
     registry.emplace_or_replace<component::actor_created>(child_actor_entity);
@@ -59,9 +64,20 @@ entity_t create_temporary_rotation_child_actor(entity_t parent_actor,
 entity_t add_skill_to_actor(const configuration::skill_t& skill,
                             entity_t actor_entity,
                             registry_t& registry) {
-    for (auto&& [skill_entity, owner_component, is_skill] :
-         registry.view<component::owner_component, component::is_skill>().each()) {
-        if (owner_component.entity == actor_entity && is_skill.skill_configuration == skill) {
+    auto skill_id = utils::get_symbol(skill.skill_key, registry);
+    auto& skill_configuration_table =
+        *registry.ctx().get<std::shared_ptr<skill_configuration_table_t>>();
+    return add_skill_to_actor(
+        skill_configuration_table.intern(skill_id, skill), actor_entity, registry);
+}
+
+entity_t add_skill_to_actor(skill_handle_t skill_handle,
+                            entity_t actor_entity,
+                            registry_t& registry) {
+    auto& skill = utils::get_skill_configuration_table(registry).get(skill_handle);
+    auto skill_id = utils::get_symbol(skill.skill_key, registry);
+    for (auto skill_entity : utils::get_skill_entities(skill_id, actor_entity, registry)) {
+        if (registry.get<component::is_skill>(skill_entity).skill_handle == skill_handle) {
             return skill_entity;
         }
     }
@@ -69,8 +85,11 @@ entity_t add_skill_to_actor(const configuration::skill_t& skill,
     auto skill_entity = registry.create();
     registry.ctx().emplace_as<std::string>(skill_entity, skill.skill_key + " skill holder entity");
 
-    registry.emplace<component::is_skill>(skill_entity, skill);
-    registry.emplace<component::owner_component>(skill_entity, actor_entity);
+    registry.emplace<component::is_skill>(skill_entity, skill_handle, skill_id);
+    utils::set_owner(skill_entity, actor_entity, registry);
+    registry.get_or_emplace<component::skill_table>(actor_entity)
+        .skill_entities[skill_id]
+        .emplace_back(skill_entity);
 
     registry.emplace<component::ammo>(skill_entity, component::ammo{skill.ammo, skill.ammo});
 
@@ -106,9 +125,11 @@ entity_t add_skill_to_actor(const configuration::skill_t& skill,
     }
 
     for (auto& child_skill : skill.child_skill_keys) {
-        auto& child_skill_configuration = utils::get_skill_configuration(
+        auto child_skill_entity = utils::get_skill_entity(
             child_skill, utils::get_owner(actor_entity, registry), registry);
-        add_skill_to_actor(child_skill_configuration, actor_entity, registry);
+        add_skill_to_actor(registry.get<component::is_skill>(child_skill_entity).skill_handle,
+                           actor_entity,
+                           registry);
     }
 
     return skill_entity;
@@ -118,14 +139,12 @@ entity_t add_conditional_skill_group_to_actor(
     const configuration::conditional_skill_group_t& conditional_skill_group,
     entity_t actor_entity,
     registry_t& registry) {
-    for (auto&& [conditional_skill_group_entity, owner_component, is_conditional_skill_group] :
-         registry.view<component::owner_component, component::is_conditional_skill_group>()
-             .each()) {
-        if (owner_component.entity == actor_entity &&
-            is_conditional_skill_group.conditional_skill_group_configuration.skill_key ==
-                conditional_skill_group.skill_key) {
-            return conditional_skill_group_entity;
-        }
+    auto skill_id = utils::get_symbol(conditional_skill_group.skill_key, registry);
+    auto& skill_table = registry.get_or_emplace<component::skill_table>(actor_entity);
+    if (auto conditional_skill_group_entity =
+            skill_table.conditional_skill_group_entities.find(skill_id);
+        conditional_skill_group_entity != skill_table.conditional_skill_group_entities.end()) {
+        return conditional_skill_group_entity->second;
     }
 
     auto conditional_skill_group_entity = registry.create();
@@ -133,9 +152,10 @@ entity_t add_conditional_skill_group_to_actor(
         conditional_skill_group_entity,
         conditional_skill_group.skill_key + " conditional skill group holder entity");
 
-    registry.emplace<component::is_conditional_skill_group>(conditional_skill_group_entity,
-                                                            conditional_skill_group);
-    registry.emplace<component::owner_component>(conditional_skill_group_entity, actor_entity);
+    registry.emplace<component::is_conditional_skill_group>(
+        conditional_skill_group_entity, conditional_skill_group, skill_id);
+    utils::set_owner(conditional_skill_group_entity, actor_entity, registry);
+    skill_table.conditional_skill_group_entities.emplace(skill_id, conditional_skill_group_entity);
     for (auto& conditional_skill_key : conditional_skill_group.conditional_skill_keys) {
         auto skill_entity =
             utils::get_skill_entity(conditional_skill_key.skill_key, actor_entity, registry);
@@ -159,16 +179,19 @@ void enqueue_child_skills(entity_t parent_actor,
     auto& rotation = registry.emplace<component::rotation_component>(
         child_actor, component::rotation_component{{}, 0, 0, false, {}});
     for (auto& skill : skills) {
-        auto& skill_configuration = utils::get_skill_configuration(skill, parent_actor, registry);
-        utils::add_skill_to_actor(skill_configuration, child_actor, registry);
-        rotation.queued_rotation.emplace_back(
-            actor::skill_cast_t{skill_configuration.skill_key, 0});
+        auto skill_handle = registry
+                                .get<component::is_skill>(
+                                    utils::get_skill_entity(skill, parent_actor, registry))
+                                .skill_handle;
+        utils::add_skill_to_actor(skill_handle, child_actor, registry);
+        rotation.queued_rotation.emplace_back(actor::skill_cast_t{
+            utils::get_skill_configuration_table(registry).get(skill_handle).skill_key, 0});
     }
 
-    spdlog::info("[{}] {}: spawned {}",
-                 utils::get_current_tick(registry),
-                 utils::get_entity_name(parent_actor, registry),
-                 utils::get_entity_name(child_actor, registry));
+    GW2COMBAT_TRACE("[{}] {}: spawned {}",
+                    utils::get_current_tick(registry),
+                    utils::get_entity_name(parent_actor, registry),
+                    utils::get_entity_name(child_actor, registry));
 }
 
 void enqueue_child_skill(const actor::skill_t& skill, entity_t parent_actor, registry_t& registry) {
@@ -184,6 +207,15 @@ void enqueue_source_actor_child_skill(const actor::skill_t& skill,
     rotation.queued_rotation.emplace_back(actor::skill_cast_t{skill, 0});
 }
 
+// The stacks of a unique effect on an actor, grouped by source actor.
+static auto get_unique_effect_stacks_by_source(symbol_t unique_effect_id,
+                                               const component::effect_stacks& effect_stacks) {
+    auto& unique_effects = effect_stacks.unique_effects;
+    return std::ranges::subrange(
+        unique_effects.lower_bound({unique_effect_id, entity_t{0}}),
+        unique_effects.upper_bound({unique_effect_id, std::numeric_limits<entity_t>::max()}));
+}
+
 entity_t add_effect_to_actor(actor::effect_t effect,
                              entity_t actor_entity,
                              entity_t source_actor,
@@ -191,31 +223,59 @@ entity_t add_effect_to_actor(actor::effect_t effect,
                              int duration,
                              int grouped_with_num_stacks,
                              registry_t& registry) {
-    // TODO: Check for crossing maximum stacks here.
     auto stacking_type = utils::get_effect_stacking_type(effect);
-    if (stacking_type == actor::stacking_t::STACKING_DURATION ||
-        stacking_type == actor::stacking_t::REPLACE) {
-        auto is_effect_view = registry.view<component::is_effect, component::owner_component>();
-        for (auto&& [effect_entity, is_effect, owner_component] : is_effect_view.each()) {
-            auto owner_actor = utils::get_owner(owner_component.entity, registry);
-            if (owner_actor != actor_entity || is_effect.effect != effect) {
-                continue;
+    if (stacking_type == actor::stacking_t::STACKING_INTENSITY) {
+        auto& effect_stacks = get_effect_stacks(effect, actor_entity, registry);
+        if (static_cast<int>(effect_stacks.size()) >=
+            utils::get_max_stored_stacks_of_effect_type(effect)) {
+            // At the stack cap, the stack with the least remaining duration is taken over in place
+            // if the new stack would outlast it.
+            auto remaining_duration = [&](entity_t effect_entity) {
+                auto& duration_component =
+                    registry.get<component::duration_component>(effect_entity);
+                return duration_component.duration -
+                       utils::get_duration_progress(duration_component, registry);
+            };
+            auto effect_entity = *std::ranges::min_element(
+                effect_stacks, std::less<>{}, remaining_duration);
+            if (remaining_duration(effect_entity) < duration) {
+                auto& stack_group =
+                    registry.get<component::effect_stacks>(actor_entity).effects.at(effect);
+                auto stack_idx = static_cast<std::size_t>(
+                    std::ranges::find(stack_group.entities, effect_entity) -
+                    stack_group.entities.begin());
+                stack_group.source_actors[stack_idx] = source_actor;
+                stack_group.source_skills[stack_idx] = utils::get_symbol(source_skill, registry);
+                registry.get<component::is_effect>(effect_entity).grouped_with_num_stacks =
+                    grouped_with_num_stacks;
+                utils::set_duration(effect_entity, duration, 0, registry);
             }
-
+            return effect_entity;
+        }
+    } else if (stacking_type == actor::stacking_t::STACKING_DURATION ||
+               stacking_type == actor::stacking_t::REPLACE) {
+        auto& effect_stacks = get_effect_stacks(effect, actor_entity, registry);
+        for (auto effect_entity : effect_stacks | std::views::reverse) {
             auto& duration_component = registry.get<component::duration_component>(effect_entity);
+            int progress = utils::get_duration_progress(duration_component, registry);
             if (stacking_type == actor::stacking_t::STACKING_DURATION) {
-                duration_component.duration = std::min(duration_component.duration + duration,
-                                                       utils::get_max_effect_duration(effect));
-                int remaining_duration = duration_component.duration - duration_component.progress;
-                duration_component.progress = 0;
-                duration_component.duration =
-                    std::min(remaining_duration + duration, utils::get_max_effect_duration(effect));
+                int remaining_duration = std::min(duration_component.duration + duration,
+                                                  utils::get_max_effect_duration(effect)) -
+                                         progress;
+                utils::set_duration(
+                    effect_entity,
+                    std::min(remaining_duration + duration, utils::get_max_effect_duration(effect)),
+                    0,
+                    registry);
                 return effect_entity;
             } else {
-                if ((duration_component.duration - duration_component.progress) > duration) {
+                if ((duration_component.duration - progress) > duration) {
                     return effect_entity;
                 }
-                duration_component.progress = duration_component.duration;
+                utils::set_duration(effect_entity,
+                                    duration_component.duration,
+                                    duration_component.duration,
+                                    registry);
                 registry.emplace_or_replace<component::destroy_entity>(effect_entity);
                 break;
             }
@@ -230,11 +290,13 @@ entity_t add_effect_to_actor(actor::effect_t effect,
     if (utils::is_damaging_condition(effect)) {
         registry.emplace<component::is_damaging_effect>(effect_entity);
     }
-    registry.emplace<component::owner_component>(effect_entity, actor_entity);
-    registry.emplace<component::source_actor>(effect_entity, source_actor);
-    registry.emplace<component::source_skill>(effect_entity, source_skill);
-    registry.emplace<component::duration_component>(effect_entity,
-                                                    component::duration_component{duration, 0});
+    utils::set_owner(effect_entity, actor_entity, registry);
+    auto& stack_group =
+        registry.get_or_emplace<component::effect_stacks>(actor_entity).effects[effect];
+    stack_group.entities.emplace_back(effect_entity);
+    stack_group.source_actors.emplace_back(source_actor);
+    stack_group.source_skills.emplace_back(utils::get_symbol(source_skill, registry));
+    utils::start_duration(effect_entity, duration, registry);
 
     if (effect == actor::effect_t::MIGHT) {
         utils::add_owner_based_component<std::vector<configuration::attribute_conversion_t>,
@@ -314,29 +376,37 @@ std::optional<entity_t> add_unique_effect_to_actor(
     const actor::skill_t& source_skill,
     int duration,
     registry_t& registry) {
+    auto unique_effect_id = utils::get_symbol(unique_effect.unique_effect_key, registry);
     int stacks_count = 0;
-    auto unique_effect_owners =
-        registry.view<component::is_unique_effect, component::owner_component>().each();
-    for (auto&& [unique_effect_entity, is_unique_effect, owner_component] : unique_effect_owners) {
-        if (owner_component.entity != actor_entity ||
-            is_unique_effect.unique_effect.unique_effect_key != unique_effect.unique_effect_key) {
-            continue;
-        }
-        ++stacks_count;
-        auto& duration_component =
-            registry.get<component::duration_component>(unique_effect_entity);
-        if (unique_effect.stacking_type == actor::stacking_t::STACKING_DURATION) {
-            int remaining_duration = duration_component.duration - duration_component.progress;
-            duration_component.progress = 0;
-            duration_component.duration = std::min(remaining_duration + duration,
-                                                   is_unique_effect.unique_effect.max_duration);
-            return unique_effect_entity;
-        } else if (unique_effect.stacking_type == actor::stacking_t::REPLACE) {
-            if ((duration_component.duration - duration_component.progress) > duration) {
-                return unique_effect_entity;
+    if (auto effect_stacks_ptr = registry.try_get<component::effect_stacks>(actor_entity)) {
+        for (auto& [key, unique_effect_stacks] :
+             get_unique_effect_stacks_by_source(unique_effect_id, *effect_stacks_ptr)) {
+            for (auto unique_effect_entity : unique_effect_stacks | std::views::reverse) {
+                ++stacks_count;
+                auto& duration_component =
+                    registry.get<component::duration_component>(unique_effect_entity);
+                int remaining_duration = duration_component.duration -
+                                         utils::get_duration_progress(duration_component, registry);
+                if (unique_effect.stacking_type == actor::stacking_t::STACKING_DURATION) {
+                    utils::set_duration(
+                        unique_effect_entity,
+                        std::min(remaining_duration + duration,
+                                 registry.get<component::is_unique_effect>(unique_effect_entity)
+                                     .unique_effect.max_duration),
+                        0,
+                        registry);
+                    return unique_effect_entity;
+                } else if (unique_effect.stacking_type == actor::stacking_t::REPLACE) {
+                    if (remaining_duration > duration) {
+                        return unique_effect_entity;
+                    }
+                    utils::set_duration(unique_effect_entity,
+                                        duration_component.duration,
+                                        duration_component.duration,
+                                        registry);
+                    registry.emplace_or_replace<component::destroy_entity>(unique_effect_entity);
+                }
             }
-            duration_component.progress = duration_component.duration;
-            registry.emplace_or_replace<component::destroy_entity>(unique_effect_entity);
         }
     }
     if (stacks_count >= unique_effect.max_stored_stacks) {
@@ -347,12 +417,15 @@ std::optional<entity_t> add_unique_effect_to_actor(
     registry.ctx().emplace_as<std::string>(
         unique_effect_entity, unique_effect.unique_effect_key + " unique-effect holder entity");
 
-    registry.emplace<component::is_unique_effect>(unique_effect_entity, unique_effect);
-    registry.emplace<component::owner_component>(unique_effect_entity, actor_entity);
+    registry.emplace<component::is_unique_effect>(
+        unique_effect_entity, unique_effect, unique_effect_id);
+    utils::set_owner(unique_effect_entity, actor_entity, registry);
+    registry.get_or_emplace<component::effect_stacks>(actor_entity)
+        .unique_effects[{unique_effect_id, source_actor}]
+        .emplace_back(unique_effect_entity);
     registry.emplace<component::source_actor>(unique_effect_entity, source_actor);
     registry.emplace<component::source_skill>(unique_effect_entity, source_skill);
-    registry.emplace<component::duration_component>(unique_effect_entity,
-                                                    component::duration_component{duration, 0});
+    utils::start_duration(unique_effect_entity, duration, registry);
 
     utils::add_owner_based_component<std::vector<configuration::attribute_conversion_t>,
                                      component::is_attribute_conversion>(
@@ -386,16 +459,14 @@ std::optional<entity_t> add_unique_effect_to_actor(
     }
 
     if (unique_effect.refreshes_other_stacks && stacks_count > 0) {
-        for (auto&& [unique_effect_entity, is_unique_effect, owner_component] :
-             unique_effect_owners) {
-            if (owner_component.entity != actor_entity ||
-                is_unique_effect.unique_effect.unique_effect_key !=
-                    unique_effect.unique_effect_key) {
-                continue;
+        auto& effect_stacks = registry.get<component::effect_stacks>(actor_entity);
+        for (auto& [key, unique_effect_stacks] :
+             get_unique_effect_stacks_by_source(unique_effect_id, effect_stacks)) {
+            for (auto stack_entity : unique_effect_stacks) {
+                auto& duration_component =
+                    registry.get<component::duration_component>(stack_entity);
+                utils::set_duration(stack_entity, duration_component.duration, 0, registry);
             }
-            auto& duration_component =
-                registry.get<component::duration_component>(unique_effect_entity);
-            duration_component.progress = 0;
         }
     }
 
@@ -464,7 +535,7 @@ void finish_casting_skill(entity_t skill_entity, entity_t actor_entity, registry
         registry.get_or_emplace<component::finished_casting_skills>(actor_entity);
     finished_casting_skills.skill_entities.emplace_back(skill_entity);
 
-    auto& skill_configuration = registry.get<component::is_skill>(skill_entity).skill_configuration;
+    auto& skill_configuration = utils::get_skill_configuration(skill_entity, registry);
     if (!(skill_configuration.skill_key == "Weapon Swap" &&
           registry.any_of<component::bundle_component>(actor_entity))) {
         auto owner_entity = utils::get_owner(actor_entity, registry);
@@ -484,4 +555,138 @@ void finish_casting_skill(entity_t skill_entity, entity_t actor_entity, registry
     //              utils::to_string(skill_configuration.skill_key));
 }
 
+const std::vector<entity_t>& get_effect_stacks(actor::effect_t effect,
+                                               entity_t actor_entity,
+                                               const registry_t& registry) {
+    static const std::vector<entity_t> no_stacks;
+    auto effect_stacks_ptr = registry.try_get<component::effect_stacks>(actor_entity);
+    if (!effect_stacks_ptr) {
+        return no_stacks;
+    }
+    auto stack_group = effect_stacks_ptr->effects.find(effect);
+    return stack_group == effect_stacks_ptr->effects.end() ? no_stacks
+                                                           : stack_group->second.entities;
+}
+
+// The stack group that an effect stack is part of and the index of the stack in it.
+static std::pair<const component::effect_stack_group_t&, std::size_t> find_effect_stack(
+    entity_t stack_entity,
+    const registry_t& registry) {
+    auto& stack_group =
+        registry
+            .get<component::effect_stacks>(
+                registry.get<component::owner_component>(stack_entity).entity)
+            .effects.at(registry.get<component::is_effect>(stack_entity).effect);
+    auto stack = std::ranges::find(stack_group.entities, stack_entity);
+    if (stack == stack_group.entities.end()) {
+        throw std::runtime_error("effect stack not found in the effect stacks of its owner");
+    }
+    return {stack_group, static_cast<std::size_t>(stack - stack_group.entities.begin())};
+}
+
+entity_t get_effect_source_actor(entity_t stack_entity, const registry_t& registry) {
+    if (!registry.any_of<component::is_effect>(stack_entity)) {
+        return registry.get<component::source_actor>(stack_entity).entity;
+    }
+    auto [stack_group, stack_idx] = find_effect_stack(stack_entity, registry);
+    return stack_group.source_actors[stack_idx];
+}
+
+symbol_t get_effect_source_skill(entity_t stack_entity, registry_t& registry) {
+    if (!registry.any_of<component::is_effect>(stack_entity)) {
+        return utils::get_symbol(registry.get<component::source_skill>(stack_entity).skill,
+                                 registry);
+    }
+    auto [stack_group, stack_idx] = find_effect_stack(stack_entity, registry);
+    return stack_group.source_skills[stack_idx];
+}
+
+bool has_unique_effect(symbol_t unique_effect_id,
+                       entity_t actor_entity,
+                       const registry_t& registry) {
+    auto effect_stacks_ptr = registry.try_get<component::effect_stacks>(actor_entity);
+    return effect_stacks_ptr &&
+           !get_unique_effect_stacks_by_source(unique_effect_id, *effect_stacks_ptr).empty();
+}
+
+const std::vector<entity_t>& get_unique_effect_stacks(symbol_t unique_effect_id,
+                                                      entity_t actor_entity,
+                                                      entity_t source_actor,
+                                                      const registry_t& registry) {
+    static const std::vector<entity_t> no_stacks;
+    auto effect_stacks_ptr = registry.try_get<component::effect_stacks>(actor_entity);
+    if (!effect_stacks_ptr) {
+        return no_stacks;
+    }
+    auto unique_effect_stacks =
+        effect_stacks_ptr->unique_effects.find({unique_effect_id, source_actor});
+    return unique_effect_stacks == effect_stacks_ptr->unique_effects.end()
+               ? no_stacks
+               : unique_effect_stacks->second;
+}
+
+void subscribe_side_effect(entity_t side_effect_entity,
+                           const component::side_effect_triggers_t& triggers,
+                           registry_t& registry) {
+    if (triggers.none()) {
+        return;
+    }
+    auto& subscriptions = registry.get_or_emplace<component::side_effect_subscriptions>(
+        utils::get_owner(side_effect_entity, registry));
+    for (std::size_t trigger = 0; trigger < component::side_effect_trigger_count; ++trigger) {
+        if (!triggers.test(trigger)) {
+            continue;
+        }
+        auto& holders = subscriptions.holders_by_trigger[trigger];
+        // Holders are destroyed along with their owners without unsubscribing, so their entries
+        // are dropped before the list grows.
+        if (holders.size() == holders.capacity()) {
+            std::erase_if(holders, [&](entity_t holder) { return !registry.valid(holder); });
+        }
+        holders.emplace_back(side_effect_entity);
+    }
+}
+
+void remove_effect_stack(entity_t stack_entity, registry_t& registry) {
+    auto owner_component_ptr = registry.try_get<component::owner_component>(stack_entity);
+    if (!owner_component_ptr || !registry.valid(owner_component_ptr->entity)) {
+        return;
+    }
+    auto effect_stacks_ptr =
+        registry.try_get<component::effect_stacks>(owner_component_ptr->entity);
+    if (!effect_stacks_ptr) {
+        return;
+    }
+    if (auto is_effect_ptr = registry.try_get<component::is_effect>(stack_entity)) {
+        auto stack_group = effect_stacks_ptr->effects.find(is_effect_ptr->effect);
+        if (stack_group == effect_stacks_ptr->effects.end()) {
+            return;
+        }
+        auto& [entities, source_actors, source_skills] = stack_group->second;
+        auto stack = std::ranges::find(entities, stack_entity);
+        if (stack == entities.end()) {
+            return;
+        }
+        auto stack_idx = stack - entities.begin();
+        entities.erase(stack);
+        source_actors.erase(source_actors.begin() + stack_idx);
+        source_skills.erase(source_skills.begin() + stack_idx);
+        if (entities.empty()) {
+            effect_stacks_ptr->effects.erase(stack_group);
+        }
+    } else if (auto is_unique_effect_ptr =
+                   registry.try_get<component::is_unique_effect>(stack_entity)) {
+        auto stacks = effect_stacks_ptr->unique_effects.find(
+            {is_unique_effect_ptr->unique_effect_id,
+             registry.get<component::source_actor>(stack_entity).entity});
+        if (stacks == effect_stacks_ptr->unique_effects.end()) {
+            return;
+        }
+        std::erase(stacks->second, stack_entity);
+        if (stacks->second.empty()) {
+            effect_stacks_ptr->unique_effects.erase(stacks);
+        }
+    }
+}
+
 }  // namespace gw2combat::utils
@@ -3,18 +3,46 @@
 
 #include "common.hpp"
 
+#include "condition_utils.hpp"
+#include "entity_utils.hpp"
 #include "io_utils.hpp"
 #include "skill_utils.hpp"
+#include "temporal_utils.hpp"
+
+#include "skill_configuration_table.hpp"
+#include "symbol_table.hpp"
+
+#include "actor/effect.hpp"
 
 #include "configuration/cooldown_modifier.hpp"
 #include "configuration/skill.hpp"
 #include "configuration/unique_effect.hpp"
 
+#include "component/actor/is_cooldown_modifier.hpp"
+#include "component/actor/side_effect_subscriptions.hpp"
+#include "component/counter/is_counter_modifier.hpp"
+#include "component/effect/is_effect_removal.hpp"
+#include "component/effect/is_skill_trigger.hpp"
 #include "component/hierarchy/owner_component.hpp"
 #include "component/temporal/cooldown_component.hpp"
 
 namespace gw2combat::utils {
 
+// The components that apply_side_effects applies.
+template <typename ComponentType>
+inline constexpr bool is_side_effect_component_v =
+    std::is_same_v<ComponentType, component::is_counter_modifier_t> ||
+    std::is_same_v<ComponentType, component::is_cooldown_modifier_t> ||
+    std::is_same_v<ComponentType, component::is_effect_removal_t> ||
+    std::is_same_v<ComponentType, component::is_skill_trigger> ||
+    std::is_same_v<ComponentType, component::is_unchained_skill_trigger> ||
+    std::is_same_v<ComponentType, component::is_source_actor_skill_trigger>;
+
+// Adds the side effect holder entity to the side effect subscriptions of its owner actor.
+void subscribe_side_effect(entity_t side_effect_entity,
+                           const component::side_effect_triggers_t& triggers,
+                           registry_t& registry);
+
 template <typename ConfigurationType, typename ComponentType>
 static inline entity_t add_owner_based_component(const ConfigurationType& configuration_type_value,
                                                  entity_t parent_entity,
@@ -24,8 +52,19 @@ static inline entity_t add_owner_based_component(const ConfigurationType& config
         component_type_holder_entity,
         std::string{utils::get_component_name_with_prefix<ConfigurationType>()} + " holder entity");
 
-    registry.emplace<component::owner_component>(component_type_holder_entity, parent_entity);
+    set_owner(component_type_holder_entity, parent_entity, registry);
     registry.emplace<ComponentType>(component_type_holder_entity, configuration_type_value);
+    if constexpr (is_side_effect_component_v<ComponentType>) {
+        component::side_effect_triggers_t triggers;
+        if constexpr (std::is_same_v<ConfigurationType, configuration::skill_trigger_t>) {
+            triggers = get_side_effect_triggers(configuration_type_value.condition);
+        } else {
+            for (auto& side_effect : configuration_type_value) {
+                triggers |= get_side_effect_triggers(side_effect.condition);
+            }
+        }
+        subscribe_side_effect(component_type_holder_entity, triggers, registry);
+    }
     return component_type_holder_entity;
 }
 
@@ -33,9 +72,14 @@ static inline entity_t add_owner_based_component(const ConfigurationType& config
                                                              const std::string& name,
                                                              int team_id,
                                                              registry_t& registry);
+// Adds the configuration to the encounter's skill configuration table first, which is only allowed
+// while the encounter is set up.
 entity_t add_skill_to_actor(const configuration::skill_t& skill,
                             entity_t actor_entity,
                             registry_t& registry);
+entity_t add_skill_to_actor(skill_handle_t skill_handle,
+                            entity_t actor_entity,
+                            registry_t& registry);
 entity_t add_conditional_skill_group_to_actor(
     const configuration::conditional_skill_group_t& conditional_skill_group,
     entity_t actor_entity,
@@ -86,6 +130,23 @@ std::vector<entity_t> add_unique_effect_to_actor(
     registry_t& registry);
 void finish_casting_skill(entity_t skill_entity, entity_t actor_entity, registry_t& registry);
 
+// Lookups into the component::effect_stacks index of an actor. Stacks are listed oldest first.
+[[nodiscard]] const std::vector<entity_t>& get_effect_stacks(actor::effect_t effect,
+                                                             entity_t actor_entity,
+                                                             const registry_t& registry);
+[[nodiscard]] bool has_unique_effect(symbol_t unique_effect_id,
+                                     entity_t actor_entity,
+                                     const registry_t& registry);
+[[nodiscard]] const std::vector<entity_t>& get_unique_effect_stacks(symbol_t unique_effect_id,
+                                                                    entity_t actor_entity,
+                                                                    entity_t source_actor,
+                                                                    const registry_t& registry);
+// The source actor and source skill of an effect or unique effect stack.
+[[nodiscard]] entity_t get_effect_source_actor(entity_t stack_entity, const registry_t& registry);
+[[nodiscard]] symbol_t get_effect_source_skill(entity_t stack_entity, registry_t& registry);
+// Must be called right before an effect or unique effect entity is destroyed.
+void remove_effect_stack(entity_t stack_entity, registry_t& registry);
+
 static inline void apply_cooldown_modifications(
     registry_t& registry,
     entity_t actor_entity,
@@ -96,28 +157,30 @@ static inline void apply_cooldown_modifications(
     if (!cooldown_ptr) {
         return;
     }
+    auto progress = utils::get_cooldown_progress(skill_entity, *cooldown_ptr, registry);
     auto operation_fn = [&](int modifier) {
         switch (cooldown_modifier.operation) {
             case configuration::cooldown_modifier_t::operation_t::ADD:
-                cooldown_ptr->progress[0] -= modifier;
+                progress[0] -= modifier;
                 break;
             case configuration::cooldown_modifier_t::operation_t::SUBTRACT:
-                cooldown_ptr->progress[0] += modifier;
+                progress[0] += modifier;
                 break;
             case configuration::cooldown_modifier_t::operation_t::SET:
-                cooldown_ptr->progress[0] = modifier;
-                cooldown_ptr->progress[1] = 0;
+                progress[0] = modifier;
+                progress[1] = 0;
                 break;
             default:
                 break;
         }
     };
     if (cooldown_modifier.operation == configuration::cooldown_modifier_t::operation_t::RESET) {
-        cooldown_ptr->progress[0] = cooldown_ptr->duration[0];
-        cooldown_ptr->progress[1] = 0;
+        progress[0] = cooldown_ptr->duration[0];
+        progress[1] = 0;
     } else {
         operation_fn(cooldown_modifier.value);
     }
+    utils::set_cooldown_progress(skill_entity, progress, registry);
 }
 
 }  // namespace gw2combat::utils
@@ -4,6 +4,7 @@
 #include <random>
 
 #include "common.hpp"
+#include "symbol_table.hpp"
 
 namespace gw2combat::utils {
 
@@ -25,17 +26,17 @@ template <typename T>
 }
 
 [[nodiscard]] static inline int get_random(int min_inclusive, int max_inclusive) {
-    static std::random_device random_device;
-    static unsigned int rng_seed = random_device();
-    static std::mt19937 generator(rng_seed);
+    thread_local std::random_device random_device;
+    thread_local unsigned int rng_seed = random_device();
+    thread_local std::mt19937 generator(rng_seed);
     std::uniform_int_distribution distribution(min_inclusive, max_inclusive);
     return distribution(generator);
 }
 
 [[nodiscard]] static inline double get_random(double min_inclusive, double max_inclusive) {
-    static std::random_device random_device;
-    static unsigned int rng_seed = random_device();
-    static std::mt19937 generator(rng_seed);
+    thread_local std::random_device random_device;
+    thread_local unsigned int rng_seed = random_device();
+    thread_local std::mt19937 generator(rng_seed);
     std::uniform_real_distribution distribution(min_inclusive, max_inclusive);
     return distribution(generator);
 }
@@ -60,6 +61,22 @@ template <typename T>
     return registry.ctx().get<const tick_t>();
 }
 
+// Returns the id of a skill, counter or unique effect key, giving the key one if it has none yet.
+[[nodiscard]] static inline symbol_t get_symbol(std::string_view key, registry_t& registry) {
+    return registry.ctx().get<symbol_table_t>().intern(key);
+}
+
+// Returns the id of a skill, counter or unique effect key, or invalid_symbol if nothing in the
+// registry has that key.
+[[nodiscard]] static inline symbol_t find_symbol(std::string_view key, const registry_t& registry) {
+    return registry.ctx().get<symbol_table_t>().find(key);
+}
+
+[[nodiscard]] static inline const std::string& get_symbol_key(symbol_t symbol,
+                                                              const registry_t& registry) {
+    return registry.ctx().get<symbol_table_t>().get_key(symbol);
+}
+
 [[nodiscard]] static inline entity_t get_singleton_entity() {
     return entity_t{0};
 }
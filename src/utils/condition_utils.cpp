@@ -1,315 +1,512 @@
 #include "condition_utils.hpp"
 
+#include <span>
+
+#include "actor_utils.hpp"
 #include "entity_utils.hpp"
 #include "skill_utils.hpp"
 
+#include "condition_program.hpp"
+
 #include "component/actor/combat_stats.hpp"
 #include "component/actor/relative_attributes.hpp"
 #include "component/counter/is_counter.hpp"
-#include "component/effect/is_effect.hpp"
-#include "component/effect/is_unique_effect.hpp"
-#include "component/effect/source_actor.hpp"
 #include "component/equipment/bundle.hpp"
 #include "component/equipment/weapons.hpp"
 #include "component/temporal/cooldown_component.hpp"
 
 namespace gw2combat::utils {
 
-[[nodiscard]] condition_result_t stage_independent_conditions_satisfied(
-    const configuration::condition_t& condition,
-    entity_t entity,
-    std::optional<entity_t> target_entity,
-    registry_t& registry) {
-    auto source_entity = utils::get_owner(entity, registry);
+using opcode_t = condition_program_t::opcode_t;
+
+[[nodiscard]] bool is_stage_dependent_condition(const configuration::condition_t& condition) {
+    return (condition.only_applies_on_strikes && *condition.only_applies_on_strikes) ||
+           (condition.only_applies_on_effect_application &&
+            *condition.only_applies_on_effect_application) ||
+           (condition.only_applies_on_finished_casting &&
+            *condition.only_applies_on_finished_casting) ||
+           (condition.only_applies_on_begun_casting && *condition.only_applies_on_begun_casting) ||
+           condition.only_applies_on_ammo_gain_of_skill;
+}
+
+component::side_effect_triggers_t get_side_effect_triggers(
+    const configuration::condition_t& condition) {
+    auto trigger_index = [](component::side_effect_trigger_t trigger) {
+        return static_cast<std::size_t>(trigger);
+    };
+    component::side_effect_triggers_t triggers;
+    if (condition.only_applies_on_strikes && *condition.only_applies_on_strikes) {
+        triggers.set(trigger_index(condition.only_applies_on_critical_strikes
+                                       ? component::side_effect_trigger_t::ON_CRITICAL_STRIKE
+                                       : component::side_effect_trigger_t::ON_STRIKE));
+    }
+    if (condition.only_applies_on_effect_application &&
+        *condition.only_applies_on_effect_application) {
+        triggers.set(trigger_index(component::side_effect_trigger_t::ON_EFFECT_APPLICATION));
+    }
+    if (condition.only_applies_on_begun_casting && *condition.only_applies_on_begun_casting) {
+        triggers.set(trigger_index(component::side_effect_trigger_t::ON_BEGUN_CASTING));
+    }
+    if (condition.only_applies_on_finished_casting &&
+        *condition.only_applies_on_finished_casting) {
+        triggers.set(trigger_index(component::side_effect_trigger_t::ON_FINISHED_CASTING));
+    }
+    if (condition.only_applies_on_ammo_gain_of_skill) {
+        triggers.set(trigger_index(component::side_effect_trigger_t::ON_AMMO_GAIN));
+    }
+    if (triggers.none()) {
+        triggers.set(trigger_index(component::side_effect_trigger_t::INDEPENDENT));
+    }
+    return triggers;
+}
+
+// Whether evaluating the condition may throw or roll a random number. Instructions are never
+// reordered across those, so that reordering changes neither which error is raised nor how many
+// random numbers are rolled.
+[[nodiscard]] static bool may_throw_or_roll(const configuration::condition_t& condition) {
+    if (condition.unique_effect_on_target || condition.unique_effect_on_target_by_source ||
+        condition.effect_on_target || condition.depends_on_skill_off_cooldown) {
+        return true;
+    }
+    if (condition.threshold &&
+        (condition.threshold->threshold_type == configuration::threshold_t::type::INVALID ||
+         (condition.threshold->generate_random_number_subject_to_threshold &&
+          *condition.threshold->generate_random_number_subject_to_threshold) ||
+         condition.threshold->counter_value_subject_to_threshold)) {
+        return true;
+    }
+    auto any_may_throw_or_roll = [](const std::vector<configuration::condition_t>& conditions) {
+        return std::any_of(conditions.begin(), conditions.end(), may_throw_or_roll);
+    };
+    return any_may_throw_or_roll(condition.not_conditions) ||
+           any_may_throw_or_roll(condition.or_conditions) ||
+           any_may_throw_or_roll(condition.and_conditions);
+}
+
+// Relative cost of an instruction that neither throws nor rolls a random number.
+[[nodiscard]] static int get_instruction_cost(
+    const condition_program_t::instruction_t& instruction) {
+    switch (instruction.opcode) {
+        case opcode_t::WEAPON_SET:
+            return 0;
+        case opcode_t::WEAPON:
+        case opcode_t::BUNDLE:
+        case opcode_t::HEALTH_PCT_THRESHOLD:
+            return 1;
+        case opcode_t::UNIQUE_EFFECT_ON_SOURCE:
+        case opcode_t::EFFECT_ON_SOURCE:
+            return 2;
+        default:
+            return 3;
+    }
+}
+
+[[nodiscard]] static bool is_reorderable(const condition_program_t::instruction_t& instruction) {
+    switch (instruction.opcode) {
+        case opcode_t::WEAPON:
+        case opcode_t::WEAPON_SET:
+        case opcode_t::BUNDLE:
+        case opcode_t::UNIQUE_EFFECT_ON_SOURCE:
+        case opcode_t::EFFECT_ON_SOURCE:
+        case opcode_t::HEALTH_PCT_THRESHOLD:
+            return true;
+        case opcode_t::NOT:
+        case opcode_t::OR:
+        case opcode_t::AND:
+            return !may_throw_or_roll(*instruction.condition);
+        default:
+            return false;
+    }
+}
+
+// Appends the instructions of a condition as a block, cheapest first, and then the blocks of its
+// composites.
+static condition_program_t::block_t compile_block(const configuration::condition_t& condition,
+                                                  condition_program_t& program,
+                                                  registry_t& registry) {
+    std::vector<condition_program_t::instruction_t> instructions;
+    auto add_instruction = [&](opcode_t opcode, std::uint32_t operand = 0) {
+        instructions.emplace_back(condition_program_t::instruction_t{
+            .opcode = opcode, .operand = operand, .size = 0, .condition = &condition});
+    };
+    auto add_symbol_instruction = [&](opcode_t opcode, const std::string& key) {
+        add_instruction(opcode, utils::get_symbol(key, registry));
+    };
+
     if (condition.weapon_type || condition.weapon_position) {
-        if (!registry.all_of<component::equipped_weapons, component::current_weapon_set>(
-                source_entity)) {
-            return {.satisfied = false, .reason = "no weapon equipped"};
-        }
-        auto& equipped_weapons = registry.get<component::equipped_weapons>(source_entity);
-        auto& current_weapon_set = registry.get<component::current_weapon_set>(source_entity);
-        bool has_bundle_equipped = registry.any_of<component::bundle_component>(source_entity);
-        bool is_satisfied = std::any_of(
-            equipped_weapons.weapons.begin(),
-            equipped_weapons.weapons.end(),
-            [&](const component::weapon_t& weapon) {
-                return weapon.set == current_weapon_set.set &&
-                       (!condition.weapon_type ||
-                        (!has_bundle_equipped && weapon.type == *condition.weapon_type)) &&
-                       (!condition.weapon_position ||
-                        (!has_bundle_equipped && weapon.position == *condition.weapon_position));
-            });
-        if (!is_satisfied) {
-            return {.satisfied = false, .reason = "weapon condition not satisfied"};
-        }
+        add_instruction(opcode_t::WEAPON);
     }
     if (condition.weapon_set) {
-        if (!registry.any_of<component::current_weapon_set>(source_entity)) {
-            return {.satisfied = false, .reason = "no weapon equipped"};
-        }
-        auto& current_weapon_set = registry.get<component::current_weapon_set>(source_entity);
-        bool is_satisfied = current_weapon_set.set == *condition.weapon_set;
-        if (!is_satisfied) {
-            return {.satisfied = false, .reason = "wrong weapon set"};
-        }
+        add_instruction(opcode_t::WEAPON_SET);
     }
     if (condition.bundle) {
-        if (!registry.any_of<component::bundle_component>(source_entity)) {
-            return {.satisfied = false, .reason = "no bundle equipped"};
-        }
-        auto& bundle = registry.get<component::bundle_component>(source_entity);
-        bool is_satisfied = bundle.name == *condition.bundle;
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("wrong bundle equipped: {}, required bundle: {}",
-                                          bundle.name,
-                                          *condition.bundle)};
-        }
+        add_instruction(opcode_t::BUNDLE);
     }
     if (condition.unique_effect_on_source) {
-        bool is_satisfied = false;
-
-        auto unique_effect_owners =
-            registry.view<component::is_unique_effect, component::owner_component>().each();
-        for (auto&& [effect_entity, is_unique_effect, owner_component] : unique_effect_owners) {
-            if (is_unique_effect.unique_effect.unique_effect_key ==
-                    *condition.unique_effect_on_source &&
-                owner_component.entity == source_entity) {
-                is_satisfied = true;
-                break;
-            }
-        }
-
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("unique effect {} not found on source",
-                                          *condition.unique_effect_on_source)};
-        }
+        add_symbol_instruction(opcode_t::UNIQUE_EFFECT_ON_SOURCE,
+                               *condition.unique_effect_on_source);
     }
     if (condition.effect_on_source) {
-        bool is_satisfied = false;
-
-        auto effect_owners =
-            registry.view<component::is_effect, component::owner_component>().each();
-        for (auto&& [effect_entity, is_effect, owner_component] : effect_owners) {
-            if (is_effect.effect == *condition.effect_on_source &&
-                owner_component.entity == source_entity) {
-                is_satisfied = true;
-                break;
+        add_instruction(opcode_t::EFFECT_ON_SOURCE,
+                        static_cast<std::uint32_t>(*condition.effect_on_source));
+    }
+    if (condition.unique_effect_on_target) {
+        add_symbol_instruction(opcode_t::UNIQUE_EFFECT_ON_TARGET,
+                               *condition.unique_effect_on_target);
+    }
+    if (condition.unique_effect_on_target_by_source) {
+        add_symbol_instruction(opcode_t::UNIQUE_EFFECT_ON_TARGET_BY_SOURCE,
+                               *condition.unique_effect_on_target_by_source);
+    }
+    if (condition.effect_on_target) {
+        add_instruction(opcode_t::EFFECT_ON_TARGET,
+                        static_cast<std::uint32_t>(*condition.effect_on_target));
+    }
+    if (condition.depends_on_skill_off_cooldown) {
+        add_symbol_instruction(opcode_t::SKILL_OFF_COOLDOWN,
+                               *condition.depends_on_skill_off_cooldown);
+    }
+    if (condition.threshold) {
+        auto& threshold = *condition.threshold;
+        if (threshold.threshold_type == configuration::threshold_t::type::INVALID) {
+            add_instruction(opcode_t::INVALID_THRESHOLD);
+        } else {
+            if (threshold.generate_random_number_subject_to_threshold &&
+                *threshold.generate_random_number_subject_to_threshold) {
+                add_instruction(opcode_t::RANDOM_NUMBER_THRESHOLD);
+            }
+            if (threshold.health_pct_subject_to_threshold &&
+                *threshold.health_pct_subject_to_threshold) {
+                add_instruction(opcode_t::HEALTH_PCT_THRESHOLD);
+            }
+            if (threshold.counter_value_subject_to_threshold) {
+                add_symbol_instruction(opcode_t::COUNTER_VALUE_THRESHOLD,
+                                       *threshold.counter_value_subject_to_threshold);
             }
-        }
-
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("effect {} not found on source",
-                                          utils::to_string(*condition.effect_on_source))};
         }
     }
-    if (condition.unique_effect_on_target) {
-        if (!target_entity) {
-            throw std::runtime_error("target_entity must be provided for unique_effect_on_target");
+    auto add_composite = [&](opcode_t opcode,
+                             const std::vector<configuration::condition_t>& conditions) {
+        if (conditions.empty()) {
+            return;
         }
+        instructions.emplace_back(condition_program_t::instruction_t{
+            .opcode = opcode,
+            .operand = static_cast<std::uint32_t>(program.child_blocks.size()),
+            .size = static_cast<std::uint32_t>(conditions.size()),
+            .condition = &condition});
+        program.child_blocks.resize(program.child_blocks.size() + conditions.size());
+    };
+    add_composite(opcode_t::NOT, condition.not_conditions);
+    add_composite(opcode_t::OR, condition.or_conditions);
+    add_composite(opcode_t::AND, condition.and_conditions);
 
-        bool is_satisfied = false;
+    for (auto first = instructions.begin(); first != instructions.end();) {
+        auto last = std::find_if_not(first, instructions.end(), is_reorderable);
+        std::stable_sort(first, last, [](auto&& lhs, auto&& rhs) {
+            return get_instruction_cost(lhs) < get_instruction_cost(rhs);
+        });
+        first = last == instructions.end() ? last : std::next(last);
+    }
 
-        auto unique_effect_owners =
-            registry.view<component::is_unique_effect, component::owner_component>().each();
-        for (auto&& [effect_entity, is_unique_effect, owner_component] : unique_effect_owners) {
-            if (is_unique_effect.unique_effect.unique_effect_key ==
-                    *condition.unique_effect_on_target &&
-                owner_component.entity == target_entity) {
-                is_satisfied = true;
-                break;
-            }
-        }
+    condition_program_t::block_t block{
+        .offset = static_cast<std::uint32_t>(program.instructions.size()),
+        .size = static_cast<std::uint32_t>(instructions.size()),
+        .condition = &condition};
+    program.instructions.insert(
+        program.instructions.end(), instructions.begin(), instructions.end());
 
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("unique effect {} not found on target",
-                                          *condition.unique_effect_on_target)};
+    for (auto& instruction : instructions) {
+        auto* conditions = instruction.opcode == opcode_t::NOT  ? &condition.not_conditions
+                           : instruction.opcode == opcode_t::OR ? &condition.or_conditions
+                           : instruction.opcode == opcode_t::AND ? &condition.and_conditions
+                                                                 : nullptr;
+        if (!conditions) {
+            continue;
         }
-    }
-    if (condition.unique_effect_on_target_by_source) {
-        if (!target_entity) {
-            throw std::runtime_error(
-                "target_entity must be provided for unique_effect_on_target_by_source");
+        for (std::uint32_t i = 0; i < instruction.size; ++i) {
+            program.child_blocks[instruction.operand + i] =
+                compile_block((*conditions)[i], program, registry);
         }
+    }
+    return block;
+}
 
-        bool is_satisfied = false;
-
-        auto unique_effect_owners = registry
-                                        .view<component::is_unique_effect,
-                                              component::owner_component,
-                                              component::source_actor>()
-                                        .each();
-        for (auto&& [effect_entity, is_unique_effect, owner_component, source_actor] :
-             unique_effect_owners) {
-            if (is_unique_effect.unique_effect.unique_effect_key ==
-                    *condition.unique_effect_on_target_by_source &&
-                owner_component.entity == target_entity && source_actor.entity == source_entity) {
-                is_satisfied = true;
-                break;
-            }
-        }
+static void compile_condition_program(const configuration::condition_t& condition,
+                                      condition_program_t& program,
+                                      registry_t& registry) {
+    program.root = compile_block(condition, program, registry);
+    program.is_stage_dependent = is_stage_dependent_condition(condition);
+    program.has_unpredictable_threshold = has_unpredictable_threshold(condition);
+}
 
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("unique effect {} not found on target by source",
-                                          *condition.unique_effect_on_target_by_source)};
-        }
+// Runs the program of the condition, or compiles a temporary one for conditions that were created
+// at runtime and never went through compile_conditions.
+template <typename Fn>
+static auto with_program(const configuration::condition_t& condition,
+                         registry_t& registry,
+                         Fn&& fn) {
+    if (condition.program) {
+        return fn(*condition.program);
     }
-    if (condition.effect_on_target) {
-        if (!target_entity) {
-            throw std::runtime_error("target_entity must be provided for effect_on_target");
-        }
+    condition_program_t program;
+    compile_condition_program(condition, program, registry);
+    return fn(program);
+}
 
-        bool is_satisfied = false;
-
-        auto effect_owners =
-            registry.view<component::is_effect, component::owner_component>().each();
-        int stacks_of_effect_on_target = 0;
-        for (auto&& [effect_entity, is_effect, owner_component] : effect_owners) {
-            if (is_effect.effect == *condition.effect_on_target &&
-                owner_component.entity == *target_entity) {
-                ++stacks_of_effect_on_target;
-                if (!condition.stacks_of_effect_on_target) {
-                    is_satisfied = true;
-                    break;
-                }
-                if (stacks_of_effect_on_target >= *condition.stacks_of_effect_on_target) {
-                    is_satisfied = true;
-                    break;
-                }
-            }
+static bool run_block(const condition_program_t& program,
+                      const condition_program_t::block_t& block,
+                      entity_t entity,
+                      entity_t source_entity,
+                      std::optional<entity_t> target_entity,
+                      registry_t& registry,
+                      std::string* failure_reason);
+
+// Returns whether the predicate of the instruction is satisfied, and sets the failure reason if it
+// isn't and a reason was asked for.
+static bool run_instruction(const condition_program_t& program,
+                            const condition_program_t::instruction_t& instruction,
+                            entity_t entity,
+                            entity_t source_entity,
+                            std::optional<entity_t> target_entity,
+                            registry_t& registry,
+                            std::string* failure_reason) {
+    auto& condition = *instruction.condition;
+    auto fail = [&](auto&& get_reason) {
+        if (failure_reason) {
+            *failure_reason = get_reason();
+        }
+        return false;
+    };
+    auto threshold_satisfied = [&](double number_subject_to_threshold) {
+        switch (condition.threshold->threshold_type) {
+            case configuration::threshold_t::type::EQUAL:
+                return number_subject_to_threshold == condition.threshold->threshold_value;
+            case configuration::threshold_t::type::UPPER_BOUND_EXCLUSIVE:
+                return number_subject_to_threshold < condition.threshold->threshold_value;
+            case configuration::threshold_t::type::UPPER_BOUND_INCLUSIVE:
+                return number_subject_to_threshold <= condition.threshold->threshold_value;
+            case configuration::threshold_t::type::LOWER_BOUND_EXCLUSIVE:
+                return number_subject_to_threshold > condition.threshold->threshold_value;
+            case configuration::threshold_t::type::LOWER_BOUND_INCLUSIVE:
+                return number_subject_to_threshold >= condition.threshold->threshold_value;
+            default:
+                throw std::runtime_error("threshold_type not implemented yet");
         }
+    };
+    auto child_blocks = [&]() {
+        return std::span{program.child_blocks}.subspan(instruction.operand, instruction.size);
+    };
 
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("stacks of effect {} on target: {}",
-                                          utils::to_string(*condition.effect_on_target),
-                                          stacks_of_effect_on_target)};
+    switch (instruction.opcode) {
+        case opcode_t::WEAPON: {
+            if (!registry.all_of<component::equipped_weapons, component::current_weapon_set>(
+                    source_entity)) {
+                return fail([] { return "no weapon equipped"; });
+            }
+            auto& equipped_weapons = registry.get<component::equipped_weapons>(source_entity);
+            auto& current_weapon_set = registry.get<component::current_weapon_set>(source_entity);
+            bool has_bundle_equipped = registry.any_of<component::bundle_component>(source_entity);
+            bool is_satisfied = std::any_of(
+                equipped_weapons.weapons.begin(),
+                equipped_weapons.weapons.end(),
+                [&](const component::weapon_t& weapon) {
+                    return weapon.set == current_weapon_set.set &&
+                           (!condition.weapon_type ||
+                            (!has_bundle_equipped && weapon.type == *condition.weapon_type)) &&
+                           (!condition.weapon_position ||
+                            (!has_bundle_equipped &&
+                             weapon.position == *condition.weapon_position));
+                });
+            return is_satisfied || fail([] { return "weapon condition not satisfied"; });
         }
-    }
-    if (condition.depends_on_skill_off_cooldown) {
-        auto skill_entity = utils::get_skill_entity(
-            *condition.depends_on_skill_off_cooldown, source_entity, registry);
-        bool is_satisfied = !registry.any_of<component::cooldown_component>(skill_entity);
-        if (!is_satisfied) {
-            return {.satisfied = false,
-                    .reason = fmt::format("skill is on cooldown",
-                                          *condition.depends_on_skill_off_cooldown)};
+        case opcode_t::WEAPON_SET: {
+            auto current_weapon_set_ptr =
+                registry.try_get<component::current_weapon_set>(source_entity);
+            if (!current_weapon_set_ptr) {
+                return fail([] { return "no weapon equipped"; });
+            }
+            return current_weapon_set_ptr->set == *condition.weapon_set ||
+                   fail([] { return "wrong weapon set"; });
         }
-    }
-    if (condition.threshold) {
-        auto threshold_satisfied = [&](double number_subject_to_threshold) {
-            switch (condition.threshold->threshold_type) {
-                case configuration::threshold_t::type::EQUAL:
-                    return number_subject_to_threshold == condition.threshold->threshold_value;
-                case configuration::threshold_t::type::UPPER_BOUND_EXCLUSIVE:
-                    return number_subject_to_threshold < condition.threshold->threshold_value;
-                case configuration::threshold_t::type::UPPER_BOUND_INCLUSIVE:
-                    return number_subject_to_threshold <= condition.threshold->threshold_value;
-                case configuration::threshold_t::type::LOWER_BOUND_EXCLUSIVE:
-                    return number_subject_to_threshold > condition.threshold->threshold_value;
-                case configuration::threshold_t::type::LOWER_BOUND_INCLUSIVE:
-                    return number_subject_to_threshold >= condition.threshold->threshold_value;
-                default:
-                    throw std::runtime_error("threshold_type not implemented yet");
+        case opcode_t::BUNDLE: {
+            auto bundle_ptr = registry.try_get<component::bundle_component>(source_entity);
+            if (!bundle_ptr) {
+                return fail([] { return "no bundle equipped"; });
             }
-        };
-        if (condition.threshold->threshold_type == configuration::threshold_t::type::INVALID) {
-            throw std::runtime_error("invalid threshold_type");
+            return bundle_ptr->name == *condition.bundle || fail([&] {
+                       return fmt::format("wrong bundle equipped: {}, required bundle: {}",
+                                          bundle_ptr->name,
+                                          *condition.bundle);
+                   });
         }
-        if (condition.threshold->generate_random_number_subject_to_threshold &&
-            *condition.threshold->generate_random_number_subject_to_threshold) {
-            if (!threshold_satisfied(utils::get_random_0_100())) {
-                return {.satisfied = false, .reason = "random number not in threshold"};
+        case opcode_t::UNIQUE_EFFECT_ON_SOURCE:
+            return utils::has_unique_effect(instruction.operand, source_entity, registry) ||
+                   fail([&] {
+                       return fmt::format("unique effect {} not found on source",
+                                          *condition.unique_effect_on_source);
+                   });
+        case opcode_t::EFFECT_ON_SOURCE:
+            return !utils::get_effect_stacks(
+                        static_cast<actor::effect_t>(instruction.operand), source_entity, registry)
+                        .empty() ||
+                   fail([&] {
+                       return fmt::format("effect {} not found on source",
+                                          utils::to_string(*condition.effect_on_source));
+                   });
+        case opcode_t::UNIQUE_EFFECT_ON_TARGET:
+            if (!target_entity) {
+                throw std::runtime_error(
+                    "target_entity must be provided for unique_effect_on_target");
+            }
+            return utils::has_unique_effect(instruction.operand, *target_entity, registry) ||
+                   fail([&] {
+                       return fmt::format("unique effect {} not found on target",
+                                          *condition.unique_effect_on_target);
+                   });
+        case opcode_t::UNIQUE_EFFECT_ON_TARGET_BY_SOURCE:
+            if (!target_entity) {
+                throw std::runtime_error(
+                    "target_entity must be provided for unique_effect_on_target_by_source");
+            }
+            return !utils::get_unique_effect_stacks(
+                        instruction.operand, *target_entity, source_entity, registry)
+                        .empty() ||
+                   fail([&] {
+                       return fmt::format("unique effect {} not found on target by source",
+                                          *condition.unique_effect_on_target_by_source);
+                   });
+        case opcode_t::EFFECT_ON_TARGET: {
+            if (!target_entity) {
+                throw std::runtime_error("target_entity must be provided for effect_on_target");
             }
+            int stacks_of_effect_on_target = static_cast<int>(
+                utils::get_effect_stacks(
+                    static_cast<actor::effect_t>(instruction.operand), *target_entity, registry)
+                    .size());
+            bool is_satisfied =
+                stacks_of_effect_on_target > 0 &&
+                (!condition.stacks_of_effect_on_target ||
+                 stacks_of_effect_on_target >= *condition.stacks_of_effect_on_target);
+            return is_satisfied || fail([&] {
+                       return fmt::format("stacks of effect {} on target: {}",
+                                          utils::to_string(*condition.effect_on_target),
+                                          stacks_of_effect_on_target);
+                   });
         }
-        if (condition.threshold->health_pct_subject_to_threshold &&
-            *condition.threshold->health_pct_subject_to_threshold) {
+        case opcode_t::SKILL_OFF_COOLDOWN: {
+            auto skill_entity =
+                utils::get_skill_entity(instruction.operand, source_entity, registry);
+            return !registry.any_of<component::cooldown_component>(skill_entity) ||
+                   fail([] { return "skill is on cooldown"; });
+        }
+        case opcode_t::INVALID_THRESHOLD:
+            throw std::runtime_error("invalid threshold_type");
+        case opcode_t::RANDOM_NUMBER_THRESHOLD:
+            return threshold_satisfied(utils::get_random_0_100()) ||
+                   fail([] { return "random number not in threshold"; });
+        case opcode_t::HEALTH_PCT_THRESHOLD: {
             double max_health = registry.get<component::relative_attributes>(source_entity)
                                     .get(entity, actor::attribute_t::MAX_HEALTH);
             double current_health = registry.get<component::combat_stats>(source_entity).health;
-            double current_health_pct = current_health / max_health;
-            if (!threshold_satisfied(current_health_pct)) {
-                return {.satisfied = false, .reason = "health pct not in threshold"};
-            }
+            return threshold_satisfied(current_health / max_health) ||
+                   fail([] { return "health pct not in threshold"; });
         }
-        if (condition.threshold->counter_value_subject_to_threshold) {
-            bool found = false;
-            int counter_value;
+        case opcode_t::COUNTER_VALUE_THRESHOLD:
             for (auto&& [counter_entity, is_counter] :
                  registry.view<component::is_counter>().each()) {
-                if (is_counter.counter_configuration.counter_key ==
-                    *condition.threshold->counter_value_subject_to_threshold) {
-                    found = true;
-                    counter_value = is_counter.value;
+                if (is_counter.counter_id == instruction.operand) {
+                    return threshold_satisfied(is_counter.value) ||
+                           fail([] { return "counter value not in threshold"; });
                 }
             }
-            if (!found) {
-                throw std::runtime_error(
-                    fmt::format("counter with name {} not found",
-                                *condition.threshold->counter_value_subject_to_threshold));
-            }
-            if (!threshold_satisfied(counter_value)) {
-                return {.satisfied = false, .reason = "counter value not in threshold"};
+            throw std::runtime_error(
+                fmt::format("counter with name {} not found",
+                            *condition.threshold->counter_value_subject_to_threshold));
+        case opcode_t::NOT: {
+            // Satisfied unless every child condition is satisfied.
+            for (auto& block : child_blocks()) {
+                if (!run_block(
+                        program, block, entity, source_entity, target_entity, registry, nullptr)) {
+                    return true;
+                }
             }
+            return fail([&] {
+                std::string reason = "{ \"not\": [";
+                for (auto& block : child_blocks()) {
+                    reason += utils::to_string(*block.condition) + ",";
+                }
+                return reason.substr(0, reason.length() - 1) + "] }";
+            });
         }
-    }
-    if (!condition.not_conditions.empty()) {
-        std::string failure_reason = "{ \"not\": [";
-        bool not_conditions_satisfied =
-            std::any_of(condition.not_conditions.begin(),
-                        condition.not_conditions.end(),
-                        [&](auto&& condition) {
-                            auto result = stage_independent_conditions_satisfied(
-                                condition, entity, target_entity, registry);
-                            if (result.satisfied) {
-                                failure_reason += utils::to_string(condition) + ",";
-                            }
-                            return !result.satisfied;
-                        });
-        failure_reason = failure_reason.substr(0, failure_reason.length() - 1) + "] }";
-        if (!not_conditions_satisfied) {
-            return {.satisfied = false, .reason = failure_reason};
-        }
-    }
-    if (!condition.or_conditions.empty()) {
-        std::string combined_failure_reason;
-        bool or_conditions_satisfied = std::any_of(
-            condition.or_conditions.begin(), condition.or_conditions.end(), [&](auto&& condition) {
-                auto result = stage_independent_conditions_satisfied(
-                    condition, entity, target_entity, registry);
-                if (!result.satisfied) {
-                    combined_failure_reason += result.reason + "; ";
+        case opcode_t::OR: {
+            std::string combined_failure_reason;
+            std::string child_failure_reason;
+            for (auto& block : child_blocks()) {
+                if (run_block(program,
+                              block,
+                              entity,
+                              source_entity,
+                              target_entity,
+                              registry,
+                              failure_reason ? &child_failure_reason : nullptr)) {
+                    return true;
                 }
-                return result.satisfied;
+                if (failure_reason) {
+                    combined_failure_reason += child_failure_reason + "; ";
+                }
+            }
+            return fail([&] {
+                return combined_failure_reason.substr(0, combined_failure_reason.length() - 2);
             });
-        if (!or_conditions_satisfied) {
-            combined_failure_reason =
-                combined_failure_reason.substr(0, combined_failure_reason.length() - 2);
-            return {.satisfied = false, .reason = combined_failure_reason};
         }
+        case opcode_t::AND:
+            for (auto& block : child_blocks()) {
+                if (!run_block(program,
+                               block,
+                               entity,
+                               source_entity,
+                               target_entity,
+                               registry,
+                               failure_reason)) {
+                    return false;
+                }
+            }
+            return true;
     }
-    if (!condition.and_conditions.empty()) {
-        std::string failure_reason;
-        bool and_conditions_satisfied =
-            std::all_of(condition.and_conditions.begin(),
-                        condition.and_conditions.end(),
-                        [&](auto&& condition) {
-                            auto result = stage_independent_conditions_satisfied(
-                                condition, entity, target_entity, registry);
-                            if (!result.satisfied) {
-                                failure_reason = result.reason;
-                            }
-                            return result.satisfied;
-                        });
-        if (!and_conditions_satisfied) {
-            return {.satisfied = false, .reason = failure_reason};
-        }
+    throw std::runtime_error("unknown condition opcode");
+}
+
+static bool run_block(const condition_program_t& program,
+                      const condition_program_t::block_t& block,
+                      entity_t entity,
+                      entity_t source_entity,
+                      std::optional<entity_t> target_entity,
+                      registry_t& registry,
+                      std::string* failure_reason) {
+    auto instructions = std::span{program.instructions}.subspan(block.offset, block.size);
+    return std::all_of(instructions.begin(), instructions.end(), [&](auto&& instruction) {
+        return run_instruction(program,
+                               instruction,
+                               entity,
+                               source_entity,
+                               target_entity,
+                               registry,
+                               failure_reason);
+    });
+}
+
+[[nodiscard]] static bool run_program(const condition_program_t& program,
+                                      entity_t entity,
+                                      std::optional<entity_t> target_entity,
+                                      registry_t& registry,
+                                      std::string* failure_reason) {
+    if (program.root.size == 0) {
+        return true;
     }
-    return {.satisfied = true, .reason = ""};
+    auto source_entity = utils::get_owner(entity, registry);
+    return run_block(
+        program, program.root, entity, source_entity, target_entity, registry, failure_reason);
 }
 
 [[nodiscard]] condition_result_t independent_conditions_satisfied(
@@ -317,16 +514,75 @@ namespace gw2combat::utils {
     entity_t entity,
     std::optional<entity_t> target_entity,
     registry_t& registry) {
-    if ((condition.only_applies_on_strikes && *condition.only_applies_on_strikes) ||
-        (condition.only_applies_on_effect_application &&
-         *condition.only_applies_on_effect_application) ||
-        (condition.only_applies_on_finished_casting &&
-         *condition.only_applies_on_finished_casting) ||
-        (condition.only_applies_on_begun_casting && *condition.only_applies_on_begun_casting) ||
-        condition.only_applies_on_ammo_gain_of_skill) {
-        return {.satisfied = false, .reason = "stage dependent condition"};
-    }
-    return stage_independent_conditions_satisfied(condition, entity, target_entity, registry);
+    return with_program(condition, registry, [&](const condition_program_t& program) {
+        if (program.is_stage_dependent) {
+            return condition_result_t{.satisfied = false, .reason = "stage dependent condition"};
+        }
+        condition_result_t result{.satisfied = false, .reason = ""};
+        result.satisfied = run_program(program, entity, target_entity, registry, &result.reason);
+        return result;
+    });
+}
+
+[[nodiscard]] bool are_independent_conditions_satisfied(
+    const configuration::condition_t& condition,
+    entity_t entity,
+    std::optional<entity_t> target_entity,
+    registry_t& registry) {
+    return with_program(condition, registry, [&](const condition_program_t& program) {
+        return !program.is_stage_dependent &&
+               run_program(program, entity, target_entity, registry, nullptr);
+    });
+}
+
+[[nodiscard]] bool has_unpredictable_threshold(const configuration::condition_t& condition) {
+    if (condition.program) {
+        return condition.program->has_unpredictable_threshold;
+    }
+    if (condition.threshold &&
+        ((condition.threshold->generate_random_number_subject_to_threshold &&
+          *condition.threshold->generate_random_number_subject_to_threshold) ||
+         (condition.threshold->health_pct_subject_to_threshold &&
+          *condition.threshold->health_pct_subject_to_threshold))) {
+        return true;
+    }
+    auto any_unpredictable = [](const std::vector<configuration::condition_t>& conditions) {
+        return std::any_of(conditions.begin(), conditions.end(), has_unpredictable_threshold);
+    };
+    return any_unpredictable(condition.not_conditions) ||
+           any_unpredictable(condition.or_conditions) ||
+           any_unpredictable(condition.and_conditions);
+}
+
+[[nodiscard]] bool independent_conditions_may_be_satisfied(
+    const configuration::condition_t& condition,
+    entity_t entity,
+    registry_t& registry) {
+    return with_program(condition, registry, [&](const condition_program_t& program) {
+        if (program.is_stage_dependent) {
+            return false;
+        }
+        // Random rolls and health thresholds cannot be evaluated ahead of time without changing
+        // the outcome, so they are assumed to be satisfiable.
+        if (program.has_unpredictable_threshold) {
+            return true;
+        }
+        try {
+            return run_program(program, entity, std::nullopt, registry, nullptr);
+        } catch (std::exception&) {
+            return true;
+        }
+    });
+}
+
+[[nodiscard]] static bool run_stage_independent_conditions(
+    const configuration::condition_t& condition,
+    entity_t entity,
+    std::optional<entity_t> target_entity,
+    registry_t& registry) {
+    return with_program(condition, registry, [&](const condition_program_t& program) {
+        return run_program(program, entity, target_entity, registry, nullptr);
+    });
 }
 
 [[nodiscard]] bool on_begun_casting_conditions_satisfied(
@@ -341,8 +597,7 @@ namespace gw2combat::utils {
            (!condition.only_applies_on_begun_casting_skill_with_tag ||
             utils::skill_has_tag(source_skill_configuration,
                                  *condition.only_applies_on_begun_casting_skill_with_tag)) &&
-           stage_independent_conditions_satisfied(condition, entity, std::nullopt, registry)
-               .satisfied;
+           run_stage_independent_conditions(condition, entity, std::nullopt, registry);
 }
 
 [[nodiscard]] bool on_finished_casting_conditions_satisfied(
@@ -358,8 +613,7 @@ namespace gw2combat::utils {
            (!condition.only_applies_on_finished_casting_skill_with_tag ||
             utils::skill_has_tag(source_skill_configuration,
                                  *condition.only_applies_on_finished_casting_skill_with_tag)) &&
-           stage_independent_conditions_satisfied(condition, entity, std::nullopt, registry)
-               .satisfied;
+           run_stage_independent_conditions(condition, entity, std::nullopt, registry);
 }
 
 [[nodiscard]] bool on_strike_conditions_satisfied(
@@ -377,8 +631,7 @@ namespace gw2combat::utils {
            (!condition.only_applies_on_strikes_by_skill_with_tag ||
             utils::skill_has_tag(source_skill_configuration,
                                  *condition.only_applies_on_strikes_by_skill_with_tag)) &&
-           stage_independent_conditions_satisfied(condition, entity, target_entity, registry)
-               .satisfied;
+           run_stage_independent_conditions(condition, entity, target_entity, registry);
 }
 
 [[nodiscard]] bool on_effect_application_conditions_satisfied(
@@ -391,8 +644,7 @@ namespace gw2combat::utils {
            *condition.only_applies_on_effect_application &&
            (!condition.only_applies_on_effect_application_of_type ||
             *condition.only_applies_on_effect_application_of_type == effect) &&
-           stage_independent_conditions_satisfied(condition, entity, target_entity, registry)
-               .satisfied;
+           run_stage_independent_conditions(condition, entity, target_entity, registry);
 }
 
 [[nodiscard]] bool on_ammo_gain_conditions_satisfied(
@@ -402,8 +654,99 @@ namespace gw2combat::utils {
     registry_t& registry) {
     return condition.only_applies_on_ammo_gain_of_skill &&
            *condition.only_applies_on_ammo_gain_of_skill == source_skill_configuration.skill_key &&
-           stage_independent_conditions_satisfied(condition, entity, std::nullopt, registry)
-               .satisfied;
+           run_stage_independent_conditions(condition, entity, std::nullopt, registry);
+}
+
+static void compile_conditions(configuration::condition_t& condition, registry_t& registry) {
+    auto program = std::make_shared<condition_program_t>();
+    program->condition = condition;
+    program->condition.program = nullptr;
+    compile_condition_program(program->condition, *program, registry);
+    condition.program = std::move(program);
+}
+
+// For configurations whose only condition is their condition member.
+template <typename T>
+static void compile_member_conditions(std::vector<T>& configurations, registry_t& registry) {
+    for (auto& configuration : configurations) {
+        compile_conditions(configuration.condition, registry);
+    }
+}
+
+static void compile_conditions(configuration::unique_effect_t& unique_effect,
+                               registry_t& registry) {
+    compile_member_conditions(unique_effect.attribute_modifiers, registry);
+    compile_member_conditions(unique_effect.attribute_conversions, registry);
+    compile_member_conditions(unique_effect.counter_modifiers, registry);
+    compile_member_conditions(unique_effect.skill_triggers, registry);
+    compile_member_conditions(unique_effect.unchained_skill_triggers, registry);
+    compile_member_conditions(unique_effect.source_actor_skill_triggers, registry);
+    compile_member_conditions(unique_effect.effect_removals, registry);
+    compile_member_conditions(unique_effect.cooldown_modifiers, registry);
+}
+
+static void compile_conditions(
+    std::vector<configuration::effect_application_t>& effect_applications,
+    registry_t& registry) {
+    for (auto& effect_application : effect_applications) {
+        compile_conditions(effect_application.condition, registry);
+        compile_conditions(effect_application.unique_effect, registry);
+    }
+}
+
+static void compile_conditions(configuration::skill_t& skill, registry_t& registry) {
+    compile_conditions(skill.on_strike_effect_applications, registry);
+    compile_conditions(skill.on_pulse_effect_applications, registry);
+    compile_member_conditions(skill.attribute_modifiers, registry);
+    compile_member_conditions(skill.attribute_conversions, registry);
+    compile_member_conditions(skill.counter_modifiers, registry);
+    compile_member_conditions(skill.skill_triggers, registry);
+    compile_member_conditions(skill.unchained_skill_triggers, registry);
+    compile_member_conditions(skill.source_actor_skill_triggers, registry);
+    compile_member_conditions(skill.effect_removals, registry);
+    compile_member_conditions(skill.cooldown_modifiers, registry);
+    compile_conditions(skill.cast_condition, registry);
+}
+
+static void compile_conditions(std::vector<configuration::unique_effect_t>& unique_effects,
+                               std::vector<configuration::skill_t>& skills,
+                               std::vector<configuration::conditional_skill_group_t>& groups,
+                               std::vector<configuration::counter_configuration_t>& counters,
+                               registry_t& registry) {
+    for (auto& unique_effect : unique_effects) {
+        compile_conditions(unique_effect, registry);
+    }
+    for (auto& skill : skills) {
+        compile_conditions(skill, registry);
+    }
+    for (auto& group : groups) {
+        compile_member_conditions(group.conditional_skill_keys, registry);
+    }
+    for (auto& counter : counters) {
+        compile_member_conditions(counter.counter_modifiers, registry);
+    }
+}
+
+void compile_conditions(configuration::recipe_t& recipe, registry_t& registry) {
+    compile_conditions(recipe.permanent_unique_effects,
+                       recipe.skills,
+                       recipe.conditional_skill_groups,
+                       recipe.counters,
+                       registry);
+}
+
+void compile_conditions(configuration::encounter_t& encounter, registry_t& registry) {
+    for (auto& actor : encounter.actors) {
+        auto& build = actor.build;
+        compile_conditions(build.permanent_unique_effects,
+                           build.skills,
+                           build.conditional_skill_groups,
+                           build.counters,
+                           registry);
+        for (auto& recipe : build.recipes) {
+            compile_conditions(recipe, registry);
+        }
+    }
 }
 
 }  // namespace gw2combat::utils
@@ -3,11 +3,15 @@
 
 #include "common.hpp"
 
+#include "configuration/build.hpp"
 #include "configuration/condition.hpp"
+#include "configuration/encounter.hpp"
 #include "configuration/skill.hpp"
 
 #include "basic_utils.hpp"
 
+#include "component/actor/side_effect_subscriptions.hpp"
+
 namespace gw2combat::utils {
 
 struct condition_result_t {
@@ -15,11 +19,35 @@ struct condition_result_t {
     std::string reason;
 };
 
+// Compiles every condition in the configuration into a condition_program_t that copies of the
+// condition share. Has to run before any of the configuration is copied into the registry.
+// Conditions that are never compiled still work, but are compiled again on every evaluation.
+extern void compile_conditions(configuration::encounter_t& encounter, registry_t& registry);
+extern void compile_conditions(configuration::recipe_t& recipe, registry_t& registry);
+
+// Returns the triggers on which side effects with this condition can fire.
+[[nodiscard]] extern component::side_effect_triggers_t get_side_effect_triggers(
+    const configuration::condition_t& condition);
+
 [[nodiscard]] extern condition_result_t independent_conditions_satisfied(
     const configuration::condition_t& condition,
     entity_t entity,
     std::optional<entity_t> target_entity,
     registry_t& registry);
+// Same as independent_conditions_satisfied, without building a failure reason.
+[[nodiscard]] extern bool are_independent_conditions_satisfied(
+    const configuration::condition_t& condition,
+    entity_t entity,
+    std::optional<entity_t> target_entity,
+    registry_t& registry);
+// Returns whether evaluating the condition rolls a random number or depends on current health.
+[[nodiscard]] extern bool has_unpredictable_threshold(const configuration::condition_t& condition);
+// Returns whether independent_conditions_satisfied could return true for this condition on the next
+// tick, given that nothing but timers progresses until then. Never rolls random numbers.
+[[nodiscard]] extern bool independent_conditions_may_be_satisfied(
+    const configuration::condition_t& condition,
+    entity_t entity,
+    registry_t& registry);
 [[nodiscard]] extern bool on_begun_casting_conditions_satisfied(
     const configuration::condition_t& condition,
     entity_t entity,
@@ -3,6 +3,8 @@
 
 #include "common.hpp"
 
+#include "basic_utils.hpp"
+
 #include "configuration/counter_configuration.hpp"
 
 #include "component/counter/is_counter.hpp"
@@ -32,10 +34,11 @@ static inline void apply_counter_modifications(
         is_counter.value = is_counter.counter_configuration.initial_value;
     } else {
         if (counter_modifier.counter_value) {
+            auto referenced_counter_id =
+                utils::find_symbol(*counter_modifier.counter_value, registry);
             registry.view<component::is_counter>().each(
                 [&](component::is_counter& referenced_counter) {
-                    if (*counter_modifier.counter_value ==
-                        referenced_counter.counter_configuration.counter_key) {
+                    if (referenced_counter.counter_id == referenced_counter_id) {
                         operation_fn(referenced_counter.value);
                     }
                 });
@@ -48,9 +51,10 @@ static inline void apply_counter_modifications(
 
 static inline component::is_counter& get_counter(const actor::counter_t& counter_key,
                                                  registry_t& registry) {
+    auto counter_id = utils::find_symbol(counter_key, registry);
     auto view = registry.view<component::is_counter>();
     for (auto&& [entity, is_counter] : view.each()) {
-        if (is_counter.counter_configuration.counter_key == counter_key) {
+        if (is_counter.counter_id == counter_id) {
             return is_counter;
         }
     }
@@ -79,7 +79,7 @@ namespace gw2combat::utils {
         case actor::effect_t::POISON:
         case actor::effect_t::CONFUSION:
             return 1500;
-        case actor::effect_t::INVALID:
+        default:
             throw std::runtime_error("cannot deal with invalid effects!");
     }
 }
@@ -3,23 +3,33 @@
 
 #include "basic_utils.hpp"
 
+#include "component/hierarchy/children_component.hpp"
 #include "component/hierarchy/owner_component.hpp"
 
 namespace gw2combat::utils {
 
-[[nodiscard]] static inline std::string get_entity_name(entity_t entity, registry_t& registry) {
-    if (!registry.ctx().contains<std::string>(entity)) {
-        return "temporary_entity";
+[[nodiscard]] static inline const std::string& get_entity_name(entity_t entity,
+                                                                const registry_t& registry) {
+    static const std::string temporary_entity_name = "temporary_entity";
+    if (auto name_ptr = registry.ctx().find<std::string>(entity)) {
+        return *name_ptr;
     }
-    return registry.ctx().get<std::string>(entity);
+    return temporary_entity_name;
 }
 
+// Returns the root of the entity's owner chain, or the entity itself if it has no owner.
 [[nodiscard]] static inline entity_t get_owner(entity_t entity, registry_t& registry) {
-    entity_t current_entity = entity;
-    while (registry.any_of<component::owner_component>(current_entity)) {
-        current_entity = registry.get<component::owner_component>(current_entity).entity;
-    }
-    return current_entity;
+    auto owner_component_ptr = registry.try_get<component::owner_component>(entity);
+    return owner_component_ptr ? owner_component_ptr->root_entity : entity;
+}
+
+// Makes the entity a child of the owner entity. Has to be called before the entity owns any other
+// entities, since their cached roots aren't updated.
+static inline void set_owner(entity_t entity, entity_t owner_entity, registry_t& registry) {
+    registry.emplace<component::owner_component>(
+        entity, owner_entity, get_owner(owner_entity, registry));
+    registry.get_or_emplace<component::children_component>(owner_entity)
+        .entities.emplace_back(entity);
 }
 
 }  // namespace gw2combat::utils
@@ -0,0 +1,74 @@
+#ifndef GW2COMBAT_UTILS_FRAME_UTILS_HPP
+#define GW2COMBAT_UTILS_FRAME_UTILS_HPP
+
+#include "common.hpp"
+
+#include "frame_buffers.hpp"
+
+#include "component/actor/begun_casting_skills.hpp"
+#include "component/actor/relative_attributes.hpp"
+#include "component/damage/buffered_condition_damage.hpp"
+#include "component/damage/effects_pipeline.hpp"
+#include "component/damage/incoming_damage.hpp"
+#include "component/damage/strikes_pipeline.hpp"
+
+namespace gw2combat::utils {
+
+// The buffers of the per-tick components whose buffers are recycled through frame_buffers_t.
+[[nodiscard]] static inline auto& get_frame_buffer(component::begun_casting_skills& value) {
+    return value.skill_entities;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::relative_attributes& value) {
+    return value.entity_and_attribute_values;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::outgoing_strikes_component& value) {
+    return value.strikes;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::incoming_strikes_component& value) {
+    return value.strikes;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::outgoing_effects_component& value) {
+    return value.effect_applications;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::incoming_effects_component& value) {
+    return value.effect_applications;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::incoming_damage& value) {
+    return value.incoming_damage_events;
+}
+[[nodiscard]] static inline auto& get_frame_buffer(component::buffered_condition_damage& value) {
+    return value.condition_damage_buffer;
+}
+
+// Like registry.get_or_emplace, except that a created component takes over a spare buffer.
+template <typename Component>
+static inline Component& get_or_emplace_frame_component(entity_t entity, registry_t& registry) {
+    if (auto component_ptr = registry.try_get<Component>(entity)) {
+        return *component_ptr;
+    }
+    auto& component = registry.emplace<Component>(entity);
+    registry.ctx().get<frame_buffers_t>().acquire(get_frame_buffer(component));
+    return component;
+}
+
+// Like registry.remove, except that the buffer of the component is kept as a spare.
+template <typename Component>
+static inline void remove_frame_component(entity_t entity, registry_t& registry) {
+    registry.ctx().get<frame_buffers_t>().release(
+        get_frame_buffer(registry.get<Component>(entity)));
+    registry.remove<Component>(entity);
+}
+
+// Like registry.clear, except that the buffers of the components are kept as spares.
+template <typename... Components>
+static inline void clear_frame_components(registry_t& registry) {
+    auto& frame_buffers = registry.ctx().get<frame_buffers_t>();
+    (registry.view<Components>().each(
+         [&](Components& component) { frame_buffers.release(get_frame_buffer(component)); }),
+     ...);
+    registry.clear<Components...>();
+}
+
+}  // namespace gw2combat::utils
+
+#endif  // GW2COMBAT_UTILS_FRAME_UTILS_HPP
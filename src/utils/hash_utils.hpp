@@ -0,0 +1,65 @@
+#ifndef GW2COMBAT_UTILS_HASH_UTILS_HPP
+#define GW2COMBAT_UTILS_HASH_UTILS_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace gw2combat::utils {
+
+struct hash128_t {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    [[nodiscard]] constexpr bool operator==(const hash128_t& rhs) const = default;
+};
+
+// Incremental 128-bit FNV-1a. Copying a hasher forks it, so the hashes of every prefix of a
+// sequence can be computed in a single pass.
+struct fnv1a_128_hasher_t {
+    __extension__ using uint128_t = unsigned __int128;
+
+    static constexpr uint128_t offset_basis =
+        (uint128_t{0x6c62272e07bb0142} << 64) | uint128_t{0x62b821756295c58d};
+    static constexpr uint128_t prime = (uint128_t{1} << 88) | uint128_t{0x13b};
+
+    uint128_t state = offset_basis;
+
+    fnv1a_128_hasher_t& update(const void* data, std::size_t size) {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            state ^= bytes[i];
+            state *= prime;
+        }
+        return *this;
+    }
+
+    // Strings are length-prefixed so that consecutive strings can't be confused with each other.
+    fnv1a_128_hasher_t& update(std::string_view str) {
+        update(str.size());
+        return update(str.data(), str.size());
+    }
+
+    template <typename T>
+        requires std::is_integral_v<T>
+    fnv1a_128_hasher_t& update(T value) {
+        return update(&value, sizeof(value));
+    }
+
+    [[nodiscard]] hash128_t digest() const {
+        return hash128_t{static_cast<std::uint64_t>(state >> 64),
+                         static_cast<std::uint64_t>(state)};
+    }
+};
+
+}  // namespace gw2combat::utils
+
+template <>
+struct std::hash<gw2combat::utils::hash128_t> {
+    std::size_t operator()(const gw2combat::utils::hash128_t& hash) const noexcept {
+        return hash.low ^ (hash.high * 0x9e3779b97f4a7c15);
+    }
+};
+
+#endif  // GW2COMBAT_UTILS_HASH_UTILS_HPP
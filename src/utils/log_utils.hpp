@@ -0,0 +1,28 @@
+#ifndef GW2COMBAT_UTILS_LOG_UTILS_HPP
+#define GW2COMBAT_UTILS_LOG_UTILS_HPP
+
+#include "common.hpp"
+
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+namespace gw2combat::utils {
+
+// Turns on simulation traces. Messages are handed to a single logging thread through a queue of
+// queue_size messages, and the oldest queued messages are dropped when it is full, so simulation
+// threads never wait on the output.
+static inline void enable_tracing(std::size_t queue_size = 8192) {
+#if SPDLOG_ACTIVE_LEVEL > SPDLOG_LEVEL_TRACE
+    spdlog::warn(
+        "Traces are compiled out of this build. Build with BUILD=debug or "
+        "-DSPDLOG_ACTIVE_LEVEL=SPDLOG_LEVEL_TRACE to get them.");
+#endif
+    spdlog::init_thread_pool(queue_size, 1);
+    spdlog::set_default_logger(
+        spdlog::stdout_color_mt<spdlog::async_factory_nonblock>("gw2combat"));
+    spdlog::set_level(spdlog::level::trace);
+}
+
+}  // namespace gw2combat::utils
+
+#endif  // GW2COMBAT_UTILS_LOG_UTILS_HPP
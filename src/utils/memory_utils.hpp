@@ -0,0 +1,724 @@
+#ifndef GW2COMBAT_UTILS_MEMORY_UTILS_HPP
+#define GW2COMBAT_UTILS_MEMORY_UTILS_HPP
+
+#include "common.hpp"
+
+#include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "condition_program.hpp"
+#include "frame_buffers.hpp"
+#include "skill_configuration_table.hpp"
+#include "symbol_table.hpp"
+#include "temporal_schedule.hpp"
+
+#include "component/actor/animation.hpp"
+#include "component/actor/begun_casting_skills.hpp"
+#include "component/actor/finished_casting_skills.hpp"
+#include "component/actor/is_cooldown_modifier.hpp"
+#include "component/actor/relative_attributes.hpp"
+#include "component/actor/rotation_component.hpp"
+#include "component/actor/side_effect_subscriptions.hpp"
+#include "component/actor/skills_actions_component.hpp"
+#include "component/attributes/is_attribute_conversion.hpp"
+#include "component/attributes/is_attribute_modifier.hpp"
+#include "component/audit/audit_component.hpp"
+#include "component/counter/is_counter.hpp"
+#include "component/counter/is_counter_modifier.hpp"
+#include "component/damage/buffered_condition_damage.hpp"
+#include "component/damage/effects_pipeline.hpp"
+#include "component/damage/incoming_damage.hpp"
+#include "component/damage/strikes_pipeline.hpp"
+#include "component/effect/effect_stacks.hpp"
+#include "component/effect/is_effect_removal.hpp"
+#include "component/effect/is_skill_trigger.hpp"
+#include "component/effect/is_unique_effect.hpp"
+#include "component/effect/source_skill.hpp"
+#include "component/encounter/encounter_configuration_component.hpp"
+#include "component/equipment/bundle.hpp"
+#include "component/equipment/weapons.hpp"
+#include "component/hierarchy/children_component.hpp"
+#include "component/skill/is_conditional_skill_group.hpp"
+#include "component/skill/skill_table.hpp"
+
+namespace gw2combat::utils {
+
+// Bytes of heap memory owned by a value, not counting sizeof the value itself. Types without an
+// overload must not own any heap memory, which is checked at compile time.
+//
+// Node sizes assume libstdc++, which puts a 32 byte header in front of every std::map and std::set
+// value and a 16 byte header in front of every std::list value.
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::string& value);
+template <typename T>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::vector<T>& value);
+template <typename T, std::size_t N>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::array<T, N>& value);
+template <typename T>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::optional<T>& value);
+template <typename T>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::list<T>& value);
+template <typename T>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::set<T>& value);
+template <typename T, typename U>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::pair<T, U>& value);
+template <typename K, typename V>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::map<K, V>& value);
+template <typename K, typename V>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const std::unordered_map<K, V>& value);
+template <typename... Ts>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::variant<Ts...>& value);
+template <typename T>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const std::shared_ptr<T>& value);
+
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::threshold_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::condition_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::attribute_modifier_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::attribute_conversion_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::counter_modifier_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::counter_configuration_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::cooldown_modifier_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::skill_trigger_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::effect_removal_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::unique_effect_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::effect_application_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const configuration::skill_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::conditional_skill_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::conditional_skill_group_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::recipe_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const configuration::build_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::skill_cast_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::rotation_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const configuration::actor_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::termination_condition_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const configuration::audit_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const configuration::encounter_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const actor::skill_cast_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const actor::rotation_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const audit::skill_cast_begin_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const audit::skill_cast_end_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const audit::equipped_bundle_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const audit::dropped_bundle_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const audit::effect_application_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const audit::damage_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const audit::effect_expired_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const audit::tick_event_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const component::animation& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::begun_casting_skills& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::finished_casting_skills& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_cooldown_modifier_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::relative_attributes& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::relative_attributes_cache& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::rotation_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::side_effect_subscriptions& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::skills_actions_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::finished_skills_actions_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_attribute_conversion& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_attribute_modifier& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::audit_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const component::is_counter& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_counter_modifier_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::buffered_condition_damage& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::outgoing_effects_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_effect_application& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_effects_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_damage& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::outgoing_strikes_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_strikes_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::effect_stack_group_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::effect_stacks& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_effect_removal_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_skill_trigger& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_unchained_skill_trigger& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_source_actor_skill_trigger& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_unique_effect& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::source_skill& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::encounter_configuration_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::bundle_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::equipped_bundle& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::dropped_bundle& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::equipped_weapons& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::children_component& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::is_conditional_skill_group& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const component::skill_table& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const symbol_table_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(
+    const skill_configuration_table_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const timer_queue_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const temporal_schedule_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const frame_buffers_t& value);
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const condition_program_t& value);
+
+template <typename T>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const T&) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "get_heap_size_in_bytes needs an overload for types that own heap memory");
+    return 0;
+}
+
+template <typename... Ts>
+[[nodiscard]] static inline std::size_t get_heap_size_in_bytes(const Ts&... values)
+    requires(sizeof...(Ts) > 1)
+{
+    return (get_heap_size_in_bytes(values) + ...);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const std::string& value) {
+    return value.capacity() > std::string{}.capacity() ? value.capacity() + 1 : 0;
+}
+
+template <typename T>
+static inline std::size_t get_heap_size_in_bytes(const std::vector<T>& value) {
+    std::size_t size = value.capacity() * sizeof(T);
+    for (auto& element : value) {
+        size += get_heap_size_in_bytes(element);
+    }
+    return size;
+}
+
+template <typename T, std::size_t N>
+static inline std::size_t get_heap_size_in_bytes(const std::array<T, N>& value) {
+    std::size_t size = 0;
+    for (auto& element : value) {
+        size += get_heap_size_in_bytes(element);
+    }
+    return size;
+}
+
+template <typename T>
+static inline std::size_t get_heap_size_in_bytes(const std::optional<T>& value) {
+    return value ? get_heap_size_in_bytes(*value) : 0;
+}
+
+template <typename T>
+static inline std::size_t get_heap_size_in_bytes(const std::list<T>& value) {
+    std::size_t size = value.size() * (16 + sizeof(T));
+    for (auto& element : value) {
+        size += get_heap_size_in_bytes(element);
+    }
+    return size;
+}
+
+template <typename T>
+static inline std::size_t get_heap_size_in_bytes(const std::set<T>& value) {
+    std::size_t size = value.size() * (32 + sizeof(T));
+    for (auto& element : value) {
+        size += get_heap_size_in_bytes(element);
+    }
+    return size;
+}
+
+template <typename T, typename U>
+static inline std::size_t get_heap_size_in_bytes(const std::pair<T, U>& value) {
+    return get_heap_size_in_bytes(value.first, value.second);
+}
+
+template <typename K, typename V>
+static inline std::size_t get_heap_size_in_bytes(const std::map<K, V>& value) {
+    std::size_t size = value.size() * (32 + sizeof(std::pair<const K, V>));
+    for (auto& element : value) {
+        size += get_heap_size_in_bytes(element);
+    }
+    return size;
+}
+
+template <typename K, typename V>
+static inline std::size_t get_heap_size_in_bytes(const std::unordered_map<K, V>& value) {
+    std::size_t size = value.bucket_count() * sizeof(void*) +
+                       value.size() * (16 + sizeof(std::pair<const K, V>));
+    for (auto& element : value) {
+        size += get_heap_size_in_bytes(element);
+    }
+    return size;
+}
+
+template <typename... Ts>
+static inline std::size_t get_heap_size_in_bytes(const std::variant<Ts...>& value) {
+    return std::visit([](auto&& alternative) { return get_heap_size_in_bytes(alternative); },
+                      value);
+}
+
+// Shared values are split evenly between their owners, so that a value shared by several cached
+// registries only counts once towards the cache's budget. The 16 bytes are the reference counts.
+template <typename T>
+static inline std::size_t get_heap_size_in_bytes(const std::shared_ptr<T>& value) {
+    if (!value) {
+        return 0;
+    }
+    return (16 + sizeof(T) + get_heap_size_in_bytes(*value)) /
+           static_cast<std::size_t>(value.use_count());
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::threshold_t& value) {
+    return get_heap_size_in_bytes(value.counter_value_subject_to_threshold);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::condition_t& value) {
+    return get_heap_size_in_bytes(value.bundle,
+                                  value.unique_effect_on_source,
+                                  value.unique_effect_on_target,
+                                  value.unique_effect_on_target_by_source,
+                                  value.depends_on_skill_off_cooldown,
+                                  value.threshold,
+                                  value.not_conditions,
+                                  value.or_conditions,
+                                  value.and_conditions,
+                                  value.only_applies_on_strikes_by_skill,
+                                  value.only_applies_on_strikes_by_skill_with_tag,
+                                  value.only_applies_on_begun_casting_skill,
+                                  value.only_applies_on_begun_casting_skill_with_tag,
+                                  value.only_applies_on_finished_casting_skill,
+                                  value.only_applies_on_finished_casting_skill_with_tag,
+                                  value.only_applies_on_ammo_gain_of_skill,
+                                  value.program);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const configuration::attribute_modifier_t& value) {
+    return get_heap_size_in_bytes(value.condition);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const configuration::attribute_conversion_t& value) {
+    return get_heap_size_in_bytes(value.condition);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::counter_modifier_t& value) {
+    return get_heap_size_in_bytes(
+        value.condition, value.counter_key, value.value, value.counter_value);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const configuration::counter_configuration_t& value) {
+    return get_heap_size_in_bytes(value.counter_key, value.counter_modifiers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::cooldown_modifier_t& value) {
+    return get_heap_size_in_bytes(value.condition, value.skill_key);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::skill_trigger_t& value) {
+    return get_heap_size_in_bytes(value.condition, value.skill_key);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::effect_removal_t& value) {
+    return get_heap_size_in_bytes(value.condition, value.unique_effect, value.num_stacks);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::unique_effect_t& value) {
+    return get_heap_size_in_bytes(value.unique_effect_key,
+                                  value.attribute_modifiers,
+                                  value.attribute_conversions,
+                                  value.counter_modifiers,
+                                  value.skill_triggers,
+                                  value.unchained_skill_triggers,
+                                  value.source_actor_skill_triggers,
+                                  value.effect_removals,
+                                  value.cooldown_modifiers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const configuration::effect_application_t& value) {
+    return get_heap_size_in_bytes(value.condition, value.unique_effect);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::skill_t& value) {
+    return get_heap_size_in_bytes(value.skill_key,
+                                  value.required_bundle,
+                                  value.attribute_damage_to_skill,
+                                  value.strike_on_tick_list,
+                                  value.pulse_on_tick_list,
+                                  value.on_strike_effect_applications,
+                                  value.on_pulse_effect_applications,
+                                  value.attribute_modifiers,
+                                  value.attribute_conversions,
+                                  value.counter_modifiers,
+                                  value.skill_triggers,
+                                  value.unchained_skill_triggers,
+                                  value.source_actor_skill_triggers,
+                                  value.effect_removals,
+                                  value.cooldown_modifiers,
+                                  value.skills_to_put_on_cooldown,
+                                  value.skills_to_cancel,
+                                  value.child_skill_keys,
+                                  value.tags,
+                                  value.whirl_finisher_on_tick_list,
+                                  value.equip_bundle,
+                                  value.drop_bundle,
+                                  value.cast_condition);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::conditional_skill_t& value) {
+    return get_heap_size_in_bytes(value.condition, value.skill_key);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const configuration::conditional_skill_group_t& value) {
+    return get_heap_size_in_bytes(value.skill_key, value.conditional_skill_keys);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::recipe_t& value) {
+    return get_heap_size_in_bytes(value.counters,
+                                  value.permanent_effects,
+                                  value.permanent_unique_effects,
+                                  value.skills,
+                                  value.conditional_skill_groups);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::build_t& value) {
+    return get_heap_size_in_bytes(value.attributes,
+                                  value.weapons,
+                                  value.skills,
+                                  value.conditional_skill_groups,
+                                  value.permanent_effects,
+                                  value.permanent_unique_effects,
+                                  value.counters,
+                                  value.recipes,
+                                  value.recipe_paths);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::skill_cast_t& value) {
+    return get_heap_size_in_bytes(value.skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::rotation_t& value) {
+    return get_heap_size_in_bytes(value.skill_casts);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::actor_t& value) {
+    return get_heap_size_in_bytes(value.name, value.build, value.rotation, value.audit_base_path);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const configuration::termination_condition_t& value) {
+    return get_heap_size_in_bytes(value.actor);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::audit_t& value) {
+    return get_heap_size_in_bytes(value.audits_to_perform);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const configuration::encounter_t& value) {
+    return get_heap_size_in_bytes(
+        value.actors, value.termination_conditions, value.audit_configuration);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const actor::skill_cast_t& value) {
+    return get_heap_size_in_bytes(value.skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const actor::rotation_t& value) {
+    return get_heap_size_in_bytes(value.skill_casts);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::skill_cast_begin_event_t& value) {
+    return get_heap_size_in_bytes(value.skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::skill_cast_end_event_t& value) {
+    return get_heap_size_in_bytes(value.skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::equipped_bundle_event_t& value) {
+    return get_heap_size_in_bytes(value.bundle);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::dropped_bundle_event_t& value) {
+    return get_heap_size_in_bytes(value.bundle);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::effect_application_event_t& value) {
+    return get_heap_size_in_bytes(
+        value.source_actor, value.source_skill, value.effect, value.unique_effect);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::damage_event_t& value) {
+    return get_heap_size_in_bytes(value.source_actor, value.source_skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::effect_expired_event_t& value) {
+    return get_heap_size_in_bytes(
+        value.source_actor, value.source_skill, value.effect, value.unique_effect);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const audit::tick_event_t& value) {
+    return get_heap_size_in_bytes(value.actor, value.event);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::animation& value) {
+    return get_heap_size_in_bytes(value.skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::begun_casting_skills& value) {
+    return get_heap_size_in_bytes(value.skill_entities);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::finished_casting_skills& value) {
+    return get_heap_size_in_bytes(value.skill_entities);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_cooldown_modifier_t& value) {
+    return get_heap_size_in_bytes(value.cooldown_modifiers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::relative_attributes& value) {
+    return get_heap_size_in_bytes(value.entity_and_attribute_values);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::relative_attributes_cache& value) {
+    return get_heap_size_in_bytes(value.attributes, value.inputs_signature);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::rotation_component& value) {
+    return get_heap_size_in_bytes(value.rotation, value.queued_rotation);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::side_effect_subscriptions& value) {
+    return get_heap_size_in_bytes(value.holders_by_trigger);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::skills_actions_component& value) {
+    return get_heap_size_in_bytes(value.skills);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::finished_skills_actions_component& value) {
+    return get_heap_size_in_bytes(value.skill_entities);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_attribute_conversion& value) {
+    return get_heap_size_in_bytes(value.attribute_conversions);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_attribute_modifier& value) {
+    return get_heap_size_in_bytes(value.attribute_modifiers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::audit_component& value) {
+    return get_heap_size_in_bytes(value.audit_configuration,
+                                  value.events,
+                                  value.afk_ticks_by_actor,
+                                  value.shared_events);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_counter& value) {
+    return get_heap_size_in_bytes(value.counter_configuration);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_counter_modifier_t& value) {
+    return get_heap_size_in_bytes(value.counter_modifiers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::buffered_condition_damage& value) {
+    return get_heap_size_in_bytes(value.condition_damage_buffer);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::outgoing_effects_component& value) {
+    return get_heap_size_in_bytes(value.effect_applications);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_effect_application& value) {
+    return get_heap_size_in_bytes(value.effect_application);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_effects_component& value) {
+    return get_heap_size_in_bytes(value.effect_applications);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::incoming_damage& value) {
+    return get_heap_size_in_bytes(value.incoming_damage_events);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::outgoing_strikes_component& value) {
+    return get_heap_size_in_bytes(value.strikes);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::incoming_strikes_component& value) {
+    return get_heap_size_in_bytes(value.strikes);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::effect_stack_group_t& value) {
+    return get_heap_size_in_bytes(value.entities, value.source_actors, value.source_skills);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::effect_stacks& value) {
+    return get_heap_size_in_bytes(value.effects) + get_heap_size_in_bytes(value.unique_effects);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_effect_removal_t& value) {
+    return get_heap_size_in_bytes(value.effect_removals);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_skill_trigger& value) {
+    return get_heap_size_in_bytes(value.skill_trigger);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::is_unchained_skill_trigger& value) {
+    return get_heap_size_in_bytes(value.skill_trigger);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::is_source_actor_skill_trigger& value) {
+    return get_heap_size_in_bytes(value.skill_trigger);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::is_unique_effect& value) {
+    return get_heap_size_in_bytes(value.unique_effect);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::source_skill& value) {
+    return get_heap_size_in_bytes(value.skill);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::encounter_configuration_component& value) {
+    return get_heap_size_in_bytes(value.encounter);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::bundle_component& value) {
+    return get_heap_size_in_bytes(value.name);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::equipped_bundle& value) {
+    return get_heap_size_in_bytes(value.name);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::dropped_bundle& value) {
+    return get_heap_size_in_bytes(value.name);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::equipped_weapons& value) {
+    return get_heap_size_in_bytes(value.weapons);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::children_component& value) {
+    return get_heap_size_in_bytes(value.entities);
+}
+
+static inline std::size_t get_heap_size_in_bytes(
+    const component::is_conditional_skill_group& value) {
+    return get_heap_size_in_bytes(value.conditional_skill_group_configuration);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const component::skill_table& value) {
+    return get_heap_size_in_bytes(value.skill_entities) +
+           get_heap_size_in_bytes(value.conditional_skill_group_entities);
+}
+
+// Every key is stored twice, once in the list of keys and once in its map node, which also holds
+// the next pointer and the cached hash.
+static inline std::size_t get_heap_size_in_bytes(const symbol_table_t& value) {
+    std::size_t size = value.keys.size() * sizeof(std::string) +
+                       value.symbols.bucket_count() * sizeof(void*) +
+                       value.symbols.size() * (16 + sizeof(std::pair<const std::string, symbol_t>));
+    for (auto& key : value.keys) {
+        size += 2 * get_heap_size_in_bytes(key);
+    }
+    return size;
+}
+
+static inline std::size_t get_heap_size_in_bytes(const skill_configuration_table_t& value) {
+    std::size_t size = value.skills.size() * sizeof(configuration::skill_t) +
+                       get_heap_size_in_bytes(value.handles_by_skill_id);
+    for (auto& skill : value.skills) {
+        size += get_heap_size_in_bytes(skill);
+    }
+    return size;
+}
+
+static inline std::size_t get_heap_size_in_bytes(const timer_queue_t& value) {
+    return get_heap_size_in_bytes(value.timers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const temporal_schedule_t& value) {
+    return get_heap_size_in_bytes(value.cooldowns, value.durations);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const frame_buffers_t& value) {
+    return std::apply(
+        [](const auto&... spare_buffers) { return (get_heap_size_in_bytes(spare_buffers) + ...); },
+        value.spare_buffers);
+}
+
+static inline std::size_t get_heap_size_in_bytes(const condition_program_t& value) {
+    return get_heap_size_in_bytes(value.condition, value.child_blocks, value.instructions);
+}
+
+}  // namespace gw2combat::utils
+
+#endif  // GW2COMBAT_UTILS_MEMORY_UTILS_HPP
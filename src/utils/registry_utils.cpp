@@ -1,6 +1,7 @@
 #include "registry_utils.hpp"
 
 #include "entity_utils.hpp"
+#include "memory_utils.hpp"
 
 #include "component/actor/animation.hpp"
 #include "component/actor/base_class_component.hpp"
@@ -15,6 +16,7 @@
 #include "component/actor/profession_component.hpp"
 #include "component/actor/relative_attributes.hpp"
 #include "component/actor/rotation_component.hpp"
+#include "component/actor/side_effect_subscriptions.hpp"
 #include "component/actor/skills_actions_component.hpp"
 #include "component/actor/static_attributes.hpp"
 #include "component/actor/team.hpp"
@@ -27,6 +29,7 @@
 #include "component/damage/effects_pipeline.hpp"
 #include "component/damage/incoming_damage.hpp"
 #include "component/damage/strikes_pipeline.hpp"
+#include "component/effect/effect_stacks.hpp"
 #include "component/effect/is_effect.hpp"
 #include "component/effect/is_effect_removal.hpp"
 #include "component/effect/is_skill_trigger.hpp"
@@ -36,12 +39,15 @@
 #include "component/encounter/encounter_configuration_component.hpp"
 #include "component/equipment/bundle.hpp"
 #include "component/equipment/weapons.hpp"
+#include "component/hierarchy/children_component.hpp"
 #include "component/hierarchy/owner_component.hpp"
 #include "component/lifecycle/destroy_entity.hpp"
 #include "component/skill/ammo.hpp"
 #include "component/skill/is_conditional_skill_group.hpp"
 #include "component/skill/is_skill.hpp"
+#include "component/skill/skill_table.hpp"
 #include "component/temporal/animation_component.hpp"
+#include "component/temporal/cooldown_clock.hpp"
 #include "component/temporal/cooldown_component.hpp"
 #include "component/temporal/duration_component.hpp"
 #include "component/temporal/has_alacrity.hpp"
@@ -49,345 +55,211 @@
 
 namespace gw2combat::utils {
 
-void copy_registry(registry_t& source_registry, registry_t& destination_registry) {
+// Every type that can be stored in a registry. Registries are copied one pool at a time, so a type
+// that is missing here would be dropped from copies; copy_registry refuses to copy such pools.
+using component_types_t = entt::type_list<
+    component::animation,
+    component::base_class_component,
+    component::begun_casting_skills,
+    component::combat_stats,
+    component::combat_stats_updated,
+    component::destroy_after_rotation,
+    component::already_finished_casting_skill,
+    component::finished_casting_skills,
+    component::actor_created,
+    component::is_actor,
+    component::is_cooldown_modifier_t,
+    component::is_downstate,
+    component::no_more_rotation,
+    component::profession_component,
+    component::relative_attributes,
+    component::relative_attributes_cache,
+    component::already_performed_rotation,
+    component::rotation_component,
+    component::side_effect_subscriptions,
+    component::finished_skills_actions_component,
+    component::skills_actions_component,
+    component::static_attributes,
+    component::team,
+    component::is_attribute_conversion,
+    component::is_attribute_modifier,
+    component::audit_component,
+    component::is_counter,
+    component::is_counter_modifier_t,
+    component::buffered_condition_damage,
+    component::condition_damage_t,
+    component::effect_application_t,
+    component::incoming_effect_application,
+    component::incoming_effects_component,
+    component::outgoing_effects_component,
+    component::incoming_damage,
+    component::incoming_damage_event,
+    component::incoming_strike,
+    component::incoming_strikes_component,
+    component::outgoing_strikes_component,
+    component::strike_t,
+    component::effect_stacks,
+    component::is_damaging_effect,
+    component::is_effect,
+    component::is_effect_removal_t,
+    component::is_skill_trigger,
+    component::is_source_actor_skill_trigger,
+    component::is_unchained_skill_trigger,
+    component::is_unique_effect,
+    component::source_actor,
+    component::source_skill,
+    component::encounter_configuration_component,
+    component::bundle_component,
+    component::dropped_bundle,
+    component::equipped_bundle,
+    component::current_weapon_set,
+    component::equipped_weapons,
+    component::weapon_t,
+    component::children_component,
+    component::owner_component,
+    component::destroy_entity,
+    component::ammo,
+    component::ammo_gained,
+    component::is_conditional_skill_group,
+    component::is_part_of_conditional_skill_group,
+    component::is_skill,
+    component::skill_table,
+    component::already_performed_animation,
+    component::animation_component,
+    component::animation_expired,
+    component::is_afk,
+    component::cooldown_clock,
+    component::cooldown_component,
+    component::cooldown_expired,
+    component::duration_component,
+    component::duration_expired,
+    component::has_alacrity,
+    component::has_quickness>;
+
+template <typename... Components>
+[[nodiscard]] bool is_component_type(entt::id_type id, entt::type_list<Components...>) {
+    return ((id == entt::type_id<Components>().hash()) || ...);
+}
+
+template <typename Component>
+void copy_component_pool(const registry_t& source_registry, registry_t& destination_registry) {
+    using sparse_set_t = entt::basic_sparse_set<entity_t>;
+
+    auto source_pool = source_registry.storage(entt::type_id<Component>().hash());
+    if (!source_pool || source_pool->empty()) {
+        return;
+    }
+    auto& source_storage =
+        static_cast<const entt::storage_for_t<Component, entity_t>&>(*source_pool);
+    auto& destination_storage = destination_registry.storage<Component>();
+    destination_storage.reserve(source_storage.size());
+    // Reverse iterators walk the packed arrays front to back, so the copy keeps the order in which
+    // the pool is iterated.
+    if constexpr (entt::component_traits<Component>::page_size == 0u) {
+        destination_storage.insert(source_storage.sparse_set_t::rbegin(),
+                                   source_storage.sparse_set_t::rend());
+    } else {
+        destination_storage.insert(source_storage.sparse_set_t::rbegin(),
+                                   source_storage.sparse_set_t::rend(),
+                                   source_storage.rbegin());
+    }
+}
+
+template <typename... Components>
+void copy_component_pools(const registry_t& source_registry,
+                          registry_t& destination_registry,
+                          entt::type_list<Components...>) {
+    (copy_component_pool<Components>(source_registry, destination_registry), ...);
+}
+
+void copy_registry(const registry_t& source_registry, registry_t& destination_registry) {
+    for (auto&& [id, pool] : source_registry.storage()) {
+        if (!pool.empty() && !is_component_type(id, component_types_t{})) {
+            throw std::runtime_error(
+                fmt::format("cannot copy registry: {} is not a known component type",
+                            pool.type().name()));
+        }
+    }
+
     destination_registry.ctx().emplace<tick_t>(source_registry.ctx().get<tick_t>());
+    destination_registry.ctx().emplace<symbol_table_t>(source_registry.ctx().get<symbol_table_t>());
+    destination_registry.ctx().emplace<std::shared_ptr<skill_configuration_table_t>>(
+        source_registry.ctx().get<std::shared_ptr<skill_configuration_table_t>>());
+    destination_registry.ctx().emplace<temporal_schedule_t>(
+        source_registry.ctx().get<temporal_schedule_t>());
+    destination_registry.ctx().emplace<frame_buffers_t>();
 
-    source_registry.each([&](auto entity) {
-        // Create entity and copy name
-        auto destination_entity = destination_registry.create(entity);
+    // Entities keep their identifiers and versions, as well as the order in which released
+    // identifiers are recycled, so the copy goes on to create the same entities as the source.
+    destination_registry.assign(source_registry.data(),
+                                source_registry.data() + source_registry.size(),
+                                source_registry.released());
+    source_registry.each([&](entity_t entity) {
         destination_registry.ctx().emplace_as<std::string>(
-            destination_entity, utils::get_entity_name(entity, source_registry));
+            entity, utils::get_entity_name(entity, source_registry));
+    });
 
-        // Copy components
-        if (source_registry.all_of<gw2combat::component::cooldown_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::cooldown_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::cooldown_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::duration_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::duration_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::duration_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::animation_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::animation_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::animation_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::owner_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::owner_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::owner_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::ammo>(entity)) {
-            destination_registry.emplace<gw2combat::component::ammo>(
-                destination_entity, source_registry.get<gw2combat::component::ammo>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_skill>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_skill>(
-                destination_entity, source_registry.get<gw2combat::component::is_skill>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_conditional_skill_group>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_conditional_skill_group>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_conditional_skill_group>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_part_of_conditional_skill_group>(
-                entity)) {
-            destination_registry.emplace<gw2combat::component::is_part_of_conditional_skill_group>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_part_of_conditional_skill_group>(
-                    entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_effect>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_effect>(
-                destination_entity, source_registry.get<gw2combat::component::is_effect>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::source_actor>(entity)) {
-            destination_registry.emplace<gw2combat::component::source_actor>(
-                destination_entity,
-                source_registry.get<gw2combat::component::source_actor>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::source_skill>(entity)) {
-            destination_registry.emplace<gw2combat::component::source_skill>(
-                destination_entity,
-                source_registry.get<gw2combat::component::source_skill>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_unique_effect>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_unique_effect>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_unique_effect>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_effect_removal_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_effect_removal_t>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_effect_removal_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_skill_trigger>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_skill_trigger>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_skill_trigger>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_unchained_skill_trigger>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_unchained_skill_trigger>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_unchained_skill_trigger>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_source_actor_skill_trigger>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_source_actor_skill_trigger>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_source_actor_skill_trigger>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::encounter_configuration_component>(
-                entity)) {
-            destination_registry.emplace<gw2combat::component::encounter_configuration_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::encounter_configuration_component>(
-                    entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_attribute_conversion>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_attribute_conversion>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_attribute_conversion>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_attribute_modifier>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_attribute_modifier>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_attribute_modifier>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::audit_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::audit_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::audit_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_counter>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_counter>(
-                destination_entity, source_registry.get<gw2combat::component::is_counter>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_counter_modifier_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_counter_modifier_t>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_counter_modifier_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::team>(entity)) {
-            destination_registry.emplace<gw2combat::component::team>(
-                destination_entity, source_registry.get<gw2combat::component::team>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::begun_casting_skills>(entity)) {
-            destination_registry.emplace<gw2combat::component::begun_casting_skills>(
-                destination_entity,
-                source_registry.get<gw2combat::component::begun_casting_skills>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::static_attributes>(entity)) {
-            destination_registry.emplace<gw2combat::component::static_attributes>(
-                destination_entity,
-                source_registry.get<gw2combat::component::static_attributes>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::animation>(entity)) {
-            destination_registry.emplace<gw2combat::component::animation>(
-                destination_entity, source_registry.get<gw2combat::component::animation>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::combat_stats>(entity)) {
-            destination_registry.emplace<gw2combat::component::combat_stats>(
-                destination_entity,
-                source_registry.get<gw2combat::component::combat_stats>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::is_cooldown_modifier_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_cooldown_modifier_t>(
-                destination_entity,
-                source_registry.get<gw2combat::component::is_cooldown_modifier_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::skills_actions_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::skills_actions_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::skills_actions_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::finished_skills_actions_component>(
-                entity)) {
-            destination_registry.emplace<gw2combat::component::finished_skills_actions_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::finished_skills_actions_component>(
-                    entity));
-        }
-        if (source_registry.all_of<gw2combat::component::finished_casting_skills>(entity)) {
-            destination_registry.emplace<gw2combat::component::finished_casting_skills>(
-                destination_entity,
-                source_registry.get<gw2combat::component::finished_casting_skills>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::base_class_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::base_class_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::base_class_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::rotation_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::rotation_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::rotation_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::profession_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::profession_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::profession_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::weapon_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::weapon_t>(
-                destination_entity, source_registry.get<gw2combat::component::weapon_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::equipped_weapons>(entity)) {
-            destination_registry.emplace<gw2combat::component::equipped_weapons>(
-                destination_entity,
-                source_registry.get<gw2combat::component::equipped_weapons>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::current_weapon_set>(entity)) {
-            destination_registry.emplace<gw2combat::component::current_weapon_set>(
-                destination_entity,
-                source_registry.get<gw2combat::component::current_weapon_set>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::bundle_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::bundle_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::bundle_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::equipped_bundle>(entity)) {
-            destination_registry.emplace<gw2combat::component::equipped_bundle>(
-                destination_entity,
-                source_registry.get<gw2combat::component::equipped_bundle>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::dropped_bundle>(entity)) {
-            destination_registry.emplace<gw2combat::component::dropped_bundle>(
-                destination_entity,
-                source_registry.get<gw2combat::component::dropped_bundle>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::strike_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::strike_t>(
-                destination_entity, source_registry.get<gw2combat::component::strike_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::incoming_strike>(entity)) {
-            destination_registry.emplace<gw2combat::component::incoming_strike>(
-                destination_entity,
-                source_registry.get<gw2combat::component::incoming_strike>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::outgoing_strikes_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::outgoing_strikes_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::outgoing_strikes_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::incoming_strikes_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::incoming_strikes_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::incoming_strikes_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::condition_damage_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::condition_damage_t>(
-                destination_entity,
-                source_registry.get<gw2combat::component::condition_damage_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::buffered_condition_damage>(entity)) {
-            destination_registry.emplace<gw2combat::component::buffered_condition_damage>(
-                destination_entity,
-                source_registry.get<gw2combat::component::buffered_condition_damage>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::effect_application_t>(entity)) {
-            destination_registry.emplace<gw2combat::component::effect_application_t>(
-                destination_entity,
-                source_registry.get<gw2combat::component::effect_application_t>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::outgoing_effects_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::outgoing_effects_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::outgoing_effects_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::incoming_effect_application>(entity)) {
-            destination_registry.emplace<gw2combat::component::incoming_effect_application>(
-                destination_entity,
-                source_registry.get<gw2combat::component::incoming_effect_application>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::incoming_effects_component>(entity)) {
-            destination_registry.emplace<gw2combat::component::incoming_effects_component>(
-                destination_entity,
-                source_registry.get<gw2combat::component::incoming_effects_component>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::incoming_damage_event>(entity)) {
-            destination_registry.emplace<gw2combat::component::incoming_damage_event>(
-                destination_entity,
-                source_registry.get<gw2combat::component::incoming_damage_event>(entity));
-        }
-        if (source_registry.all_of<gw2combat::component::incoming_damage>(entity)) {
-            destination_registry.emplace<gw2combat::component::incoming_damage>(
-                destination_entity,
-                source_registry.get<gw2combat::component::incoming_damage>(entity));
-        }
+    copy_component_pools(source_registry, destination_registry, component_types_t{});
+}
 
-        // Copy tags
-        if (source_registry.all_of<gw2combat::component::has_quickness>(entity)) {
-            destination_registry.emplace<gw2combat::component::has_quickness>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::cooldown_expired>(entity)) {
-            destination_registry.emplace<gw2combat::component::cooldown_expired>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::duration_expired>(entity)) {
-            destination_registry.emplace<gw2combat::component::duration_expired>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::already_performed_animation>(entity)) {
-            destination_registry.emplace<gw2combat::component::already_performed_animation>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::animation_expired>(entity)) {
-            destination_registry.emplace<gw2combat::component::animation_expired>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::has_alacrity>(entity)) {
-            destination_registry.emplace<gw2combat::component::has_alacrity>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::ammo_gained>(entity)) {
-            destination_registry.emplace<gw2combat::component::ammo_gained>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::destroy_entity>(entity)) {
-            destination_registry.emplace<gw2combat::component::destroy_entity>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::is_afk>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_afk>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::is_damaging_effect>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_damaging_effect>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::destroy_after_rotation>(entity)) {
-            destination_registry.emplace<gw2combat::component::destroy_after_rotation>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::is_downstate>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_downstate>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::combat_stats_updated>(entity)) {
-            destination_registry.emplace<gw2combat::component::combat_stats_updated>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::relative_attributes>(entity)) {
-            destination_registry.emplace<gw2combat::component::relative_attributes>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::is_actor>(entity)) {
-            destination_registry.emplace<gw2combat::component::is_actor>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::actor_created>(entity)) {
-            destination_registry.emplace<gw2combat::component::actor_created>(destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::no_more_rotation>(entity)) {
-            destination_registry.emplace<gw2combat::component::no_more_rotation>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::already_finished_casting_skill>(entity)) {
-            destination_registry.emplace<gw2combat::component::already_finished_casting_skill>(
-                destination_entity);
-        }
-        if (source_registry.all_of<gw2combat::component::already_performed_rotation>(entity)) {
-            destination_registry.emplace<gw2combat::component::already_performed_rotation>(
-                destination_entity);
+template <typename Component>
+std::size_t get_component_pool_size_in_bytes(const registry_t& registry) {
+    auto pool = registry.storage(entt::type_id<Component>().hash());
+    if (!pool) {
+        return 0;
+    }
+    if constexpr (entt::component_traits<Component>::page_size == 0u) {
+        // Empty types don't store any objects, only the entities counted with the pool itself.
+        return 0;
+    } else {
+        auto& storage = static_cast<const entt::storage_for_t<Component, entity_t>&>(*pool);
+        std::size_t size_in_bytes = storage.capacity() * sizeof(Component);
+        for (auto&& [entity, component] : storage.each()) {
+            size_in_bytes += get_heap_size_in_bytes(component);
+        }
+        return size_in_bytes;
+    }
+}
+
+template <typename... Components>
+std::size_t get_component_pools_size_in_bytes(const registry_t& registry,
+                                               entt::type_list<Components...>) {
+    return (get_component_pool_size_in_bytes<Components>(registry) + ...);
+}
+
+std::size_t get_registry_size_in_bytes(const registry_t& registry) {
+    using sparse_set_t = entt::basic_sparse_set<entity_t>;
+
+    std::size_t size_in_bytes = sizeof(registry_t) + registry.capacity() * sizeof(entity_t);
+    for (auto&& [id, pool] : registry.storage()) {
+        size_in_bytes += sizeof(sparse_set_t) +
+                         (pool.sparse_set_t::capacity() + pool.extent()) * sizeof(entity_t);
+    }
+    registry.each([&](entity_t entity) {
+        if (auto name_ptr = registry.ctx().find<std::string>(entity)) {
+            size_in_bytes += sizeof(entt::any) + sizeof(std::string) +
+                             get_heap_size_in_bytes(*name_ptr);
         }
     });
+    if (auto symbol_table_ptr = registry.ctx().find<symbol_table_t>()) {
+        size_in_bytes += sizeof(entt::any) + sizeof(symbol_table_t) +
+                         get_heap_size_in_bytes(*symbol_table_ptr);
+    }
+    if (auto skill_configuration_table_ptr =
+            registry.ctx().find<std::shared_ptr<skill_configuration_table_t>>()) {
+        size_in_bytes += sizeof(entt::any) + sizeof(std::shared_ptr<skill_configuration_table_t>) +
+                         get_heap_size_in_bytes(*skill_configuration_table_ptr);
+    }
+    if (auto temporal_schedule_ptr = registry.ctx().find<temporal_schedule_t>()) {
+        size_in_bytes += sizeof(entt::any) + sizeof(temporal_schedule_t) +
+                         get_heap_size_in_bytes(*temporal_schedule_ptr);
+    }
+    if (auto frame_buffers_ptr = registry.ctx().find<frame_buffers_t>()) {
+        size_in_bytes += sizeof(entt::any) + sizeof(frame_buffers_t) +
+                         get_heap_size_in_bytes(*frame_buffers_ptr);
+    }
+    size_in_bytes += get_component_pools_size_in_bytes(registry, component_types_t{});
+    return size_in_bytes;
 }
 
 }  // namespace gw2combat::utils
@@ -5,7 +5,10 @@
 
 namespace gw2combat::utils {
 
-extern void copy_registry(registry_t& source_registry, registry_t& destination_registry);
+extern void copy_registry(const registry_t& source_registry, registry_t& destination_registry);
+// Bytes of memory held by the registry: entity and component pools including their unused capacity,
+// the heap memory owned by components and the entity names.
+[[nodiscard]] extern std::size_t get_registry_size_in_bytes(const registry_t& registry);
 
 }  // namespace gw2combat::utils
 
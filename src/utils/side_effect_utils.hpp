@@ -9,6 +9,7 @@
 
 #include "component/actor/is_cooldown_modifier.hpp"
 #include "component/actor/rotation_component.hpp"
+#include "component/actor/side_effect_subscriptions.hpp"
 #include "component/counter/is_counter_modifier.hpp"
 #include "component/effect/is_effect.hpp"
 #include "component/effect/is_effect_removal.hpp"
@@ -18,12 +19,66 @@
 
 namespace gw2combat::utils {
 
+// Returns the holders of the side effect component that the owner actor subscribed to the
+// trigger, in the order that a view of the component iterates them, and drops the entries of
+// destroyed holders. Critical strikes also return the holders subscribed to strikes.
+template <typename ComponentType>
+[[nodiscard]] inline std::vector<entity_t> get_subscribed_side_effects(
+    registry_t& registry,
+    entity_t owner_actor,
+    component::side_effect_trigger_t trigger) {
+    std::vector<entity_t> side_effect_entities;
+    auto subscriptions_ptr = registry.try_get<component::side_effect_subscriptions>(owner_actor);
+    if (!subscriptions_ptr) {
+        return side_effect_entities;
+    }
+    auto collect = [&](component::side_effect_trigger_t subscribed_trigger) {
+        auto& holders =
+            subscriptions_ptr->holders_by_trigger[static_cast<std::size_t>(subscribed_trigger)];
+        std::erase_if(holders, [&](entity_t holder) { return !registry.valid(holder); });
+        for (auto holder : holders) {
+            if (registry.all_of<ComponentType>(holder)) {
+                side_effect_entities.emplace_back(holder);
+            }
+        }
+    };
+    collect(trigger);
+    if (trigger == component::side_effect_trigger_t::ON_CRITICAL_STRIKE) {
+        collect(component::side_effect_trigger_t::ON_STRIKE);
+    }
+    auto& storage = registry.storage<ComponentType>();
+    std::sort(side_effect_entities.begin(),
+              side_effect_entities.end(),
+              [&](entity_t lhs, entity_t rhs) { return storage.index(lhs) > storage.index(rhs); });
+    side_effect_entities.erase(
+        std::unique(side_effect_entities.begin(), side_effect_entities.end()),
+        side_effect_entities.end());
+    return side_effect_entities;
+}
+
+// Calls fn with every holder of the side effect component that the owner actor subscribed to the
+// trigger. Holders added by fn are not visited, like in a view.
+template <typename ComponentType, typename T>
+inline void for_each_subscribed_side_effect(registry_t& registry,
+                                            entity_t owner_actor,
+                                            component::side_effect_trigger_t trigger,
+                                            T fn) {
+    for (auto side_effect_entity :
+         get_subscribed_side_effects<ComponentType>(registry, owner_actor, trigger)) {
+        fn(side_effect_entity, registry.get<ComponentType>(side_effect_entity));
+    }
+}
+
 template <typename T>
 inline void apply_side_effects(registry_t& registry,
                                entity_t source_entity,
+                               component::side_effect_trigger_t trigger,
                                T side_effect_condition_fn) {
     auto source_entity_owner = utils::get_owner(source_entity, registry);
-    registry.view<component::is_counter_modifier_t>().each(
+    for_each_subscribed_side_effect<component::is_counter_modifier_t>(
+        registry,
+        source_entity_owner,
+        trigger,
         [&](entity_t counter_modifier_entity,
             const component::is_counter_modifier_t& is_counter_modifier) {
             auto owner_actor = utils::get_owner(counter_modifier_entity, registry);
@@ -37,7 +92,10 @@ inline void apply_side_effects(registry_t& registry,
                 }
             }
         });
-    registry.view<component::is_cooldown_modifier_t>().each(
+    for_each_subscribed_side_effect<component::is_cooldown_modifier_t>(
+        registry,
+        source_entity_owner,
+        trigger,
         [&](entity_t cooldown_modifier_entity,
             const component::is_cooldown_modifier_t& is_cooldown_modifier) {
             auto owner_actor = utils::get_owner(cooldown_modifier_entity, registry);
@@ -50,7 +108,10 @@ inline void apply_side_effects(registry_t& registry,
                 }
             }
         });
-    registry.view<component::is_effect_removal_t>().each(
+    for_each_subscribed_side_effect<component::is_effect_removal_t>(
+        registry,
+        source_entity_owner,
+        trigger,
         [&](entity_t effect_removal_entity, component::is_effect_removal_t& is_effect_removal) {
             auto owner_entity = utils::get_owner(effect_removal_entity, registry);
             if (owner_entity != source_entity_owner) {
@@ -80,13 +141,14 @@ inline void apply_side_effects(registry_t& registry,
                     if (!effect_removal.unique_effect.empty()) {
                         int stacks_to_remove =
                             effect_removal.num_stacks ? *effect_removal.num_stacks : 5000;
+                        auto unique_effect_id =
+                            utils::find_symbol(effect_removal.unique_effect, registry);
                         registry.view<component::is_unique_effect, component::owner_component>()
                             .each([&](entity_t unique_effect_entity,
                                       const component::is_unique_effect& is_unique_effect,
                                       const component::owner_component& effect_owner) {
                                 if (effect_owner.entity == source_entity_owner &&
-                                    is_unique_effect.unique_effect.unique_effect_key ==
-                                        effect_removal.unique_effect) {
+                                    is_unique_effect.unique_effect_id == unique_effect_id) {
                                     if (stacks_to_remove <= 0) {
                                         return;
                                     }
@@ -99,7 +161,10 @@ inline void apply_side_effects(registry_t& registry,
                 }
             }
         });
-    registry.view<component::is_skill_trigger>().each(
+    for_each_subscribed_side_effect<component::is_skill_trigger>(
+        registry,
+        source_entity_owner,
+        trigger,
         [&](entity_t skill_trigger_entity, component::is_skill_trigger& is_skill_trigger) {
             auto owner_entity = utils::get_owner(skill_trigger_entity, registry);
             if (owner_entity != source_entity_owner) {
@@ -113,7 +178,10 @@ inline void apply_side_effects(registry_t& registry,
                     is_skill_trigger.skill_trigger.skill_key, source_entity_owner, registry);
             }
         });
-    registry.view<component::is_unchained_skill_trigger>().each(
+    for_each_subscribed_side_effect<component::is_unchained_skill_trigger>(
+        registry,
+        source_entity_owner,
+        trigger,
         [&](entity_t skill_trigger_entity,
             const component::is_unchained_skill_trigger& is_unchained_skill_trigger) {
             auto owner_entity = utils::get_owner(skill_trigger_entity, registry);
@@ -125,7 +193,10 @@ inline void apply_side_effects(registry_t& registry,
                 utils::enqueue_child_skill(skill_trigger.skill_key, source_entity_owner, registry);
             }
         });
-    registry.view<component::is_source_actor_skill_trigger>().each(
+    for_each_subscribed_side_effect<component::is_source_actor_skill_trigger>(
+        registry,
+        source_entity_owner,
+        trigger,
         [&](entity_t skill_trigger_entity,
             const component::is_source_actor_skill_trigger& is_source_actor_skill_trigger) {
             auto owner_entity = utils::get_owner(skill_trigger_entity, registry);
@@ -144,6 +215,82 @@ inline void apply_side_effects(registry_t& registry,
         });
 }
 
+// Returns whether applying the side effects owned by the source entity's owner with the same
+// condition function would trigger at least one of them. Nothing is applied.
+template <typename T>
+inline bool any_side_effect_condition_satisfied(registry_t& registry,
+                                                entity_t source_entity,
+                                                component::side_effect_trigger_t trigger,
+                                                T side_effect_condition_fn) {
+    auto source_entity_owner = utils::get_owner(source_entity, registry);
+    auto is_owned = [&](entity_t side_effect_entity) {
+        return utils::get_owner(side_effect_entity, registry) == source_entity_owner;
+    };
+    for (auto entity : get_subscribed_side_effects<component::is_counter_modifier_t>(
+             registry, source_entity_owner, trigger)) {
+        auto& is_counter_modifier = registry.get<component::is_counter_modifier_t>(entity);
+        if (is_owned(entity) &&
+            std::any_of(is_counter_modifier.counter_modifiers.begin(),
+                        is_counter_modifier.counter_modifiers.end(),
+                        [&](auto&& counter_modifier) {
+                            return side_effect_condition_fn(counter_modifier.condition);
+                        })) {
+            return true;
+        }
+    }
+    for (auto entity : get_subscribed_side_effects<component::is_cooldown_modifier_t>(
+             registry, source_entity_owner, trigger)) {
+        auto& is_cooldown_modifier = registry.get<component::is_cooldown_modifier_t>(entity);
+        if (is_owned(entity) &&
+            std::any_of(is_cooldown_modifier.cooldown_modifiers.begin(),
+                        is_cooldown_modifier.cooldown_modifiers.end(),
+                        [&](auto&& cooldown_modifier) {
+                            return side_effect_condition_fn(cooldown_modifier.condition);
+                        })) {
+            return true;
+        }
+    }
+    for (auto entity : get_subscribed_side_effects<component::is_effect_removal_t>(
+             registry, source_entity_owner, trigger)) {
+        auto& is_effect_removal = registry.get<component::is_effect_removal_t>(entity);
+        if (is_owned(entity) && std::any_of(is_effect_removal.effect_removals.begin(),
+                                            is_effect_removal.effect_removals.end(),
+                                            [&](auto&& effect_removal) {
+                                                return side_effect_condition_fn(
+                                                    effect_removal.condition);
+                                            })) {
+            return true;
+        }
+    }
+    for (auto entity : get_subscribed_side_effects<component::is_skill_trigger>(
+             registry, source_entity_owner, trigger)) {
+        auto& is_skill_trigger = registry.get<component::is_skill_trigger>(entity);
+        if (is_owned(entity) && !is_skill_trigger.already_triggered &&
+            side_effect_condition_fn(is_skill_trigger.skill_trigger.condition)) {
+            return true;
+        }
+    }
+    for (auto entity : get_subscribed_side_effects<component::is_unchained_skill_trigger>(
+             registry, source_entity_owner, trigger)) {
+        auto& is_unchained_skill_trigger =
+            registry.get<component::is_unchained_skill_trigger>(entity);
+        if (is_owned(entity) &&
+            side_effect_condition_fn(is_unchained_skill_trigger.skill_trigger.condition)) {
+            return true;
+        }
+    }
+    for (auto entity : get_subscribed_side_effects<component::is_source_actor_skill_trigger>(
+             registry, source_entity_owner, trigger)) {
+        auto& is_source_actor_skill_trigger =
+            registry.get<component::is_source_actor_skill_trigger>(entity);
+        if (is_owned(entity) &&
+            side_effect_condition_fn(is_source_actor_skill_trigger.skill_trigger.condition)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace gw2combat::utils
 
 #endif  // GW2COMBAT_UTILS_SIDE_EFFECT_UTILS_HPP
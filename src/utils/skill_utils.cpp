@@ -4,12 +4,14 @@
 #include "condition_utils.hpp"
 #include "entity_utils.hpp"
 #include "io_utils.hpp"
+#include "temporal_utils.hpp"
 
 #include "component/equipment/bundle.hpp"
 #include "component/equipment/weapons.hpp"
 #include "component/skill/ammo.hpp"
 #include "component/skill/is_conditional_skill_group.hpp"
 #include "component/skill/is_skill.hpp"
+#include "component/skill/skill_table.hpp"
 #include "component/temporal/cooldown_component.hpp"
 
 namespace gw2combat::utils {
@@ -22,7 +24,7 @@ skill_castability_t can_cast_skill(entity_t skill_entity, registry_t& registry)
 
     auto bundle_ptr = registry.try_get<component::bundle_component>(actor_entity);
     auto& skill_ammo = registry.get<component::ammo>(skill_entity);
-    auto& skill_configuration = registry.get<component::is_skill>(skill_entity).skill_configuration;
+    auto& skill_configuration = utils::get_skill_configuration(skill_entity, registry);
     if (skill_ammo.current_ammo <= 0 &&
         !(skill_configuration.skill_key == "Weapon Swap" && bundle_ptr)) {
         // auto& cooldown_component = registry.get<component::cooldown_component>(skill_entity);
@@ -35,8 +37,7 @@ skill_castability_t can_cast_skill(entity_t skill_entity, registry_t& registry)
                 .reason = skill_ammo.max_ammo > 1
                               ? "skill doesn't have any more ammo"
                               : "skill is on cooldown: " +
-                                    utils::to_string(
-                                        registry.get<component::cooldown_component>(skill_entity))};
+                                    utils::cooldown_to_string(skill_entity, registry)};
     }
 
     if (skill_configuration.required_bundle.empty()) {
@@ -82,46 +83,119 @@ skill_castability_t can_cast_skill(entity_t skill_entity, registry_t& registry)
 entity_t get_skill_entity(const actor::skill_t& skill,
                           entity_t actor_entity,
                           registry_t& registry) {
-    for (auto&& [skill_entity, owner_component, is_skill] :
-         registry.view<component::owner_component, component::is_skill>().each()) {
-        if (owner_component.entity == actor_entity &&
-            is_skill.skill_configuration.skill_key == skill) {
-            return skill_entity;
-        }
+    return get_skill_entity(utils::get_symbol(skill, registry), actor_entity, registry);
+}
+
+const std::vector<entity_t>& get_skill_entities(symbol_t skill_id,
+                                                entity_t actor_entity,
+                                                const registry_t& registry) {
+    static const std::vector<entity_t> no_skill_entities;
+    auto skill_table_ptr = registry.try_get<component::skill_table>(actor_entity);
+    if (!skill_table_ptr) {
+        return no_skill_entities;
+    }
+    auto skill_entities = skill_table_ptr->skill_entities.find(skill_id);
+    return skill_entities == skill_table_ptr->skill_entities.end() ? no_skill_entities
+                                                                    : skill_entities->second;
+}
+
+std::optional<entity_t> find_skill_entity(symbol_t skill_id,
+                                          entity_t actor_entity,
+                                          const registry_t& registry) {
+    auto& skill_entities = get_skill_entities(skill_id, actor_entity, registry);
+    if (skill_entities.empty()) {
+        return std::nullopt;
+    }
+    if (skill_entities.size() == 1) {
+        return skill_entities.front();
+    }
+    // The skill that a view of skills visits first, which starts from the back of the pool.
+    auto& is_skill_storage = registry.storage<component::is_skill>();
+    return *std::max_element(
+        skill_entities.begin(), skill_entities.end(), [&](entity_t lhs, entity_t rhs) {
+            return is_skill_storage.index(lhs) < is_skill_storage.index(rhs);
+        });
+}
+
+entity_t get_skill_entity(symbol_t skill_id, entity_t actor_entity, registry_t& registry) {
+    if (auto skill_entity = find_skill_entity(skill_id, actor_entity, registry)) {
+        return *skill_entity;
+    }
+    std::string failure_reason =
+        fmt::format("skill {} not found for actor {}",
+                    utils::get_symbol_key(skill_id, registry),
+                    utils::get_entity_name(actor_entity, registry));
+
+    auto skill_table_ptr = registry.try_get<component::skill_table>(actor_entity);
+    if (!skill_table_ptr) {
+        throw std::runtime_error(failure_reason);
     }
-    std::string failure_reason = fmt::format(
-        "skill {} not found for actor {}", skill, utils::get_entity_name(actor_entity, registry));
-
-    for (auto&& [conditional_skill_group_entity, owner_component, is_conditional_skill_group] :
-         registry.view<component::owner_component, component::is_conditional_skill_group>()
-             .each()) {
-        if (owner_component.entity == actor_entity &&
-            is_conditional_skill_group.conditional_skill_group_configuration.skill_key == skill) {
-            failure_reason =
-                fmt::format("no condition satisfied in conditional skill group {} for actor {}",
-                            skill,
-                            utils::get_entity_name(actor_entity, registry));
-            for (auto& conditional_skill_key :
-                 is_conditional_skill_group.conditional_skill_group_configuration
-                     .conditional_skill_keys) {
-                auto skill_entity =
-                    get_skill_entity(conditional_skill_key.skill_key, actor_entity, registry);
-                if (utils::independent_conditions_satisfied(
-                        conditional_skill_key.condition, actor_entity, std::nullopt, registry)
-                        .satisfied) {
-                    return skill_entity;
-                }
+    auto conditional_skill_group_entity =
+        skill_table_ptr->conditional_skill_group_entities.find(skill_id);
+    if (conditional_skill_group_entity !=
+        skill_table_ptr->conditional_skill_group_entities.end()) {
+        auto& is_conditional_skill_group = registry.get<component::is_conditional_skill_group>(
+            conditional_skill_group_entity->second);
+        failure_reason =
+            fmt::format("no condition satisfied in conditional skill group {} for actor {}",
+                        utils::get_symbol_key(skill_id, registry),
+                        utils::get_entity_name(actor_entity, registry));
+        for (auto& conditional_skill_key :
+             is_conditional_skill_group.conditional_skill_group_configuration
+                 .conditional_skill_keys) {
+            auto skill_entity =
+                get_skill_entity(conditional_skill_key.skill_key, actor_entity, registry);
+            if (utils::are_independent_conditions_satisfied(
+                    conditional_skill_key.condition, actor_entity, std::nullopt, registry)) {
+                return skill_entity;
             }
         }
     }
     throw std::runtime_error(failure_reason);
 }
 
-configuration::skill_t& get_skill_configuration(const actor::skill_t& skill,
-                                                entity_t actor_entity,
-                                                registry_t& registry) {
-    auto skill_entity = utils::get_skill_entity(skill, actor_entity, registry);
-    return registry.get<component::is_skill>(skill_entity).skill_configuration;
+const skill_configuration_table_t& get_skill_configuration_table(const registry_t& registry) {
+    return *registry.ctx().get<std::shared_ptr<skill_configuration_table_t>>();
+}
+
+const configuration::skill_t& get_skill_configuration(const component::is_skill& is_skill,
+                                                      const registry_t& registry) {
+    return get_skill_configuration_table(registry).get(is_skill.skill_handle);
+}
+
+const configuration::skill_t& get_skill_configuration(entity_t skill_entity,
+                                                      const registry_t& registry) {
+    return get_skill_configuration(registry.get<component::is_skill>(skill_entity), registry);
+}
+
+const configuration::skill_t& get_skill_configuration(const actor::skill_t& skill,
+                                                      entity_t actor_entity,
+                                                      registry_t& registry) {
+    return get_skill_configuration(utils::get_skill_entity(skill, actor_entity, registry),
+                                   registry);
+}
+
+const configuration::skill_t& get_skill_configuration(symbol_t skill_id,
+                                                      entity_t actor_entity,
+                                                      registry_t& registry) {
+    return get_skill_configuration(utils::get_skill_entity(skill_id, actor_entity, registry),
+                                   registry);
+}
+
+const configuration::effect_application_t& get_effect_application_configuration(
+    const component::effect_application_t& effect_application, const registry_t& registry) {
+    auto& skill_configuration =
+        get_skill_configuration_table(registry).get(effect_application.skill_handle);
+    auto& effect_applications =
+        effect_application.skill_action == component::effect_application_t::skill_action_t::STRIKE
+            ? skill_configuration.on_strike_effect_applications
+            : skill_configuration.on_pulse_effect_applications;
+    return effect_applications.at(effect_application.application_idx);
+}
+
+const actor::skill_t& get_effect_application_source_skill(
+    const component::effect_application_t& effect_application, const registry_t& registry) {
+    return get_skill_configuration_table(registry).get(effect_application.skill_handle).skill_key;
 }
 
 bool skill_has_tag(const configuration::skill_t& skill, const actor::skill_tag_t& skill_tag) {
@@ -129,32 +203,30 @@ bool skill_has_tag(const configuration::skill_t& skill, const actor::skill_tag_t
 }
 
 void put_skill_on_cooldown(entity_t skill_entity, registry_t& registry, bool force) {
-    auto& skill_configuration = registry.get<component::is_skill>(skill_entity).skill_configuration;
+    auto& skill_configuration = utils::get_skill_configuration(skill_entity, registry);
     if (skill_configuration.cooldown[0] == 0) {
         return;
     }
 
     auto& skill_ammo = registry.get<component::ammo>(skill_entity);
     if (skill_ammo.current_ammo <= 0 && !force) {
-        auto& cooldown_component = registry.get<component::cooldown_component>(skill_entity);
         throw std::runtime_error(fmt::format(
             "put_skill_on_cooldown: actor {} skill {} doesn't have any more ammo. cooldown: {}",
             utils::get_entity_name(registry.get<component::owner_component>(skill_entity).entity,
                                    registry),
             skill_configuration.skill_key,
-            utils::to_string(cooldown_component)));
+            utils::cooldown_to_string(skill_entity, registry)));
     }
     skill_ammo.current_ammo = std::max(skill_ammo.current_ammo - 1, 0);
 
     if (!registry.any_of<component::cooldown_component>(skill_entity)) {
-        registry.emplace_or_replace<component::cooldown_component>(
-            skill_entity, component::cooldown_component{skill_configuration.cooldown});
+        utils::start_cooldown(skill_entity, skill_configuration.cooldown, registry);
     }
-    spdlog::info("[{}] {}: put_skill_on_cooldown: skill {}",
-                 utils::get_current_tick(registry),
-                 utils::get_entity_name(
-                     registry.get<component::owner_component>(skill_entity).entity, registry),
-                 skill_configuration.skill_key);
+    GW2COMBAT_TRACE("[{}] {}: put_skill_on_cooldown: skill {}",
+                    utils::get_current_tick(registry),
+                    utils::get_entity_name(
+                        registry.get<component::owner_component>(skill_entity).entity, registry),
+                    skill_configuration.skill_key);
 }
 
 }  // namespace gw2combat::utils
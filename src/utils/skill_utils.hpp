@@ -1,10 +1,16 @@
 #ifndef GW2COMBAT_UTILS_SKILL_UTILS_HPP
 #define GW2COMBAT_UTILS_SKILL_UTILS_HPP
 
+#include "skill_configuration_table.hpp"
+#include "symbol_table.hpp"
+
 #include "actor/skill.hpp"
 
 #include "configuration/skill.hpp"
 
+#include "component/damage/effects_pipeline.hpp"
+#include "component/skill/is_skill.hpp"
+
 namespace gw2combat::utils {
 
 struct skill_castability_t {
@@ -14,12 +20,38 @@ struct skill_castability_t {
 
 [[nodiscard]] extern skill_castability_t can_cast_skill(entity_t skill_entity,
                                                         registry_t& registry);
+// Returns the skill entities of the actor with the skill id, in the order they were added.
+[[nodiscard]] extern const std::vector<entity_t>& get_skill_entities(symbol_t skill_id,
+                                                                     entity_t actor_entity,
+                                                                     const registry_t& registry);
+// Returns the skill entity of the actor with the skill id, without resolving conditional skill
+// groups. Of several skills with the same id, the one that a view of skills visits first is
+// returned.
+[[nodiscard]] extern std::optional<entity_t> find_skill_entity(symbol_t skill_id,
+                                                               entity_t actor_entity,
+                                                               const registry_t& registry);
 [[nodiscard]] extern entity_t get_skill_entity(const actor::skill_t& skill,
                                                entity_t actor_entity,
                                                registry_t& registry);
-[[nodiscard]] extern configuration::skill_t& get_skill_configuration(const actor::skill_t& skill,
-                                                                     entity_t actor_entity,
-                                                                     registry_t& registry);
+[[nodiscard]] extern entity_t get_skill_entity(symbol_t skill_id,
+                                               entity_t actor_entity,
+                                               registry_t& registry);
+[[nodiscard]] extern const skill_configuration_table_t& get_skill_configuration_table(
+    const registry_t& registry);
+[[nodiscard]] extern const configuration::skill_t& get_skill_configuration(
+    const component::is_skill& is_skill, const registry_t& registry);
+[[nodiscard]] extern const configuration::skill_t& get_skill_configuration(
+    entity_t skill_entity, const registry_t& registry);
+[[nodiscard]] extern const configuration::skill_t& get_skill_configuration(
+    const actor::skill_t& skill, entity_t actor_entity, registry_t& registry);
+[[nodiscard]] extern const configuration::skill_t& get_skill_configuration(
+    symbol_t skill_id, entity_t actor_entity, registry_t& registry);
+[[nodiscard]] extern const configuration::effect_application_t&
+get_effect_application_configuration(const component::effect_application_t& effect_application,
+                                     const registry_t& registry);
+// Returns the key of the skill that the effect application was configured for.
+[[nodiscard]] extern const actor::skill_t& get_effect_application_source_skill(
+    const component::effect_application_t& effect_application, const registry_t& registry);
 [[nodiscard]] extern bool skill_has_tag(const configuration::skill_t& skill,
                                         const actor::skill_tag_t& skill_tag);
 extern void put_skill_on_cooldown(entity_t skill_entity, registry_t& registry, bool force = false);
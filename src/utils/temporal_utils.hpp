@@ -0,0 +1,135 @@
+#ifndef GW2COMBAT_UTILS_TEMPORAL_UTILS_HPP
+#define GW2COMBAT_UTILS_TEMPORAL_UTILS_HPP
+
+#include "common.hpp"
+
+#include "entity_utils.hpp"
+
+#include "temporal_schedule.hpp"
+
+#include "component/temporal/cooldown_clock.hpp"
+#include "component/temporal/cooldown_component.hpp"
+#include "component/temporal/duration_component.hpp"
+
+namespace gw2combat::utils {
+
+// Returns the number of ticks until progress[progress_idx] pushes the combined progress of a
+// quickness/alacrity split duration to 100%, or 1 if that cannot be determined without stepping.
+[[nodiscard]] static inline int ticks_until_progress_completes(const std::array<int, 2>& duration,
+                                                               const std::array<int, 2>& progress,
+                                                               int progress_idx) {
+    if (duration[0] == 0 || duration[1] == 0) {
+        return 1;
+    }
+    int other_idx = 1 - progress_idx;
+    int required_progress_pct = 100 - progress[other_idx] * 100 / duration[other_idx];
+    if (required_progress_pct <= 0) {
+        return 1;
+    }
+    int required_progress = (required_progress_pct * duration[progress_idx] + 99) / 100;
+    return std::max(1, required_progress - progress[progress_idx]);
+}
+
+[[nodiscard]] static inline temporal_schedule_t& get_temporal_schedule(registry_t& registry) {
+    return registry.ctx().get<temporal_schedule_t>();
+}
+
+[[nodiscard]] static inline int get_duration_progress(const component::duration_component& duration,
+                                                      const registry_t& registry) {
+    return static_cast<int>(registry.ctx().get<temporal_schedule_t>().durations.step -
+                            duration.start_step);
+}
+
+[[nodiscard]] static inline std::int64_t get_expiry_step(
+    const component::duration_component& duration) {
+    return duration.start_step + duration.duration;
+}
+
+// Sets the duration and progress of the entity's duration, which expires once its progress
+// reaches its duration.
+static inline void set_duration(entity_t entity, int duration, int progress, registry_t& registry) {
+    auto& durations = get_temporal_schedule(registry).durations;
+    auto& duration_component = registry.get<component::duration_component>(entity);
+    auto previous_expiry_step = get_expiry_step(duration_component);
+    duration_component.duration = duration;
+    duration_component.start_step = durations.step - progress;
+    if (get_expiry_step(duration_component) != previous_expiry_step) {
+        durations.schedule(entity, get_expiry_step(duration_component));
+    }
+}
+
+static inline void start_duration(entity_t entity, int duration, registry_t& registry) {
+    auto& durations = get_temporal_schedule(registry).durations;
+    auto& duration_component = registry.emplace<component::duration_component>(
+        entity, component::duration_component{duration, durations.step});
+    durations.schedule(entity, get_expiry_step(duration_component));
+}
+
+[[nodiscard]] static inline std::int64_t get_expiry_step(
+    const component::cooldown_component& cooldown) {
+    return cooldown.expiry_step;
+}
+
+[[nodiscard]] static inline std::array<int, 2> get_cooldown_progress(
+    const component::cooldown_component& cooldown,
+    const component::cooldown_clock& cooldown_clock) {
+    return {static_cast<int>(cooldown_clock.steps[0] - cooldown.start_steps[0]),
+            static_cast<int>(cooldown_clock.steps[1] - cooldown.start_steps[1])};
+}
+
+[[nodiscard]] static inline std::array<int, 2> get_cooldown_progress(
+    entity_t entity,
+    const component::cooldown_component& cooldown,
+    registry_t& registry) {
+    return get_cooldown_progress(
+        cooldown, registry.get<component::cooldown_clock>(utils::get_owner(entity, registry)));
+}
+
+// Describes the cooldown by its duration and progress, for failure reasons and errors.
+[[nodiscard]] static inline std::string cooldown_to_string(entity_t entity, registry_t& registry) {
+    auto& cooldown = registry.get<component::cooldown_component>(entity);
+    return nlohmann::json{{"duration", cooldown.duration},
+                          {"progress", get_cooldown_progress(entity, cooldown, registry)}}
+        .dump();
+}
+
+// Projects the step at which the cooldown expires from its current progress, assuming that its
+// owner actor keeps the alacrity it had when its cooldowns last progressed.
+static inline void schedule_cooldown(entity_t entity,
+                                     component::cooldown_component& cooldown,
+                                     registry_t& registry) {
+    auto& cooldowns = get_temporal_schedule(registry).cooldowns;
+    auto& cooldown_clock =
+        registry.get<component::cooldown_clock>(utils::get_owner(entity, registry));
+    cooldown.expiry_step =
+        cooldowns.step + ticks_until_progress_completes(cooldown.duration,
+                                                        get_cooldown_progress(cooldown,
+                                                                              cooldown_clock),
+                                                        cooldown_clock.has_alacrity);
+    cooldowns.schedule(entity, cooldown.expiry_step);
+}
+
+static inline void set_cooldown_progress(entity_t entity,
+                                         const std::array<int, 2>& progress,
+                                         registry_t& registry) {
+    auto& cooldown = registry.get<component::cooldown_component>(entity);
+    auto& cooldown_clock =
+        registry.get<component::cooldown_clock>(utils::get_owner(entity, registry));
+    cooldown.start_steps = {cooldown_clock.steps[0] - progress[0],
+                            cooldown_clock.steps[1] - progress[1]};
+    schedule_cooldown(entity, cooldown, registry);
+}
+
+static inline void start_cooldown(entity_t entity,
+                                  const std::array<int, 2>& duration,
+                                  registry_t& registry) {
+    auto& cooldown_clock =
+        registry.get_or_emplace<component::cooldown_clock>(utils::get_owner(entity, registry));
+    auto& cooldown = registry.emplace<component::cooldown_component>(
+        entity, component::cooldown_component{duration, cooldown_clock.steps});
+    schedule_cooldown(entity, cooldown, registry);
+}
+
+}  // namespace gw2combat::utils
+
+#endif  // GW2COMBAT_UTILS_TEMPORAL_UTILS_HPP